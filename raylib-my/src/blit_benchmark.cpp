@@ -0,0 +1,98 @@
+#include "blit_benchmark.h"
+
+#include <chrono>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+#include "config/game_config.h"
+#include "graphics/headless_graphics.h"
+#include "graphics/rgba8_blit.h"
+#include "services/service_locator.h"
+#include "services/tiles_manager.h"
+
+namespace {
+
+constexpr int kGridSize = 32;
+
+struct TileSprite {
+  ImageHandle source;
+  ImageHandle sprite;
+};
+
+}
+
+int RunBlitBenchmark(const GameConfig& baseConfig, int iterations) {
+  // The unscaled routes read the per-terrain source images, so keep them on the CPU
+  GameConfig config = baseConfig;
+  config.TerrainResidency = "both";
+  ServiceLocator::Initialize(config);
+  HeadlessGraphics graphics { config.ScreenWidth, config.ScreenHeight, config.TileWidth, config.TileHeight };
+  ServiceLocator::LoadResources(static_cast<ResourcesSystem&>(graphics));
+
+  std::vector<TileSprite> sprites;
+  for (const auto& [name, tileType] : ServiceLocator::GetTilesManager().TileTypes()) {
+    sprites.push_back({ tileType.TextureImage(), tileType.Sprite(TileFrameStyle::Outlined) });
+  }
+
+  // Same layout as a world chunk: a kGridSize x kGridSize diamond of tiles
+  float halfWidth = config.TileWidth * 0.5f;
+  float halfHeight = config.TileHeight * 0.5f;
+  ImageHandle chunk = graphics.GenImageColor(kGridSize * config.TileWidth, kGridSize * config.TileHeight, Color2D(0, 0, 0, 0));
+  std::vector<Position2D> origins;
+  for (int y = 0; y < kGridSize; ++y) {
+    for (int x = 0; x < kGridSize; ++x) {
+      origins.push_back({ (x - y + kGridSize - 1) * halfWidth, (x + y) * halfHeight });
+    }
+  }
+
+  auto measure = [&](const char* name, const std::function<void(const TileSprite&, Position2D)>& draw) {
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; ++i) {
+      for (size_t t = 0; t < origins.size(); ++t) {
+        draw(sprites[t % sprites.size()], origins[t]);
+      }
+    }
+    double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    double tiles = double(iterations) * origins.size();
+    std::cout << std::left << std::setw(22) << name << std::right << std::fixed << std::setprecision(1)
+              << std::setw(10) << ms * 1.0e6 / tiles << " ns/tile  "
+              << std::setw(8) << tiles * config.TileWidth * config.TileHeight / (ms * 1.0e3) << " Mpx/s" << std::endl;
+    return ms;
+  };
+
+  std::cout << "Blitting " << origins.size() << " tiles x " << iterations << " iterations, "
+            << config.TileWidth << "x" << config.TileHeight << " px tiles" << std::endl;
+  measure("Scale + frame lines", [&](const TileSprite& sprite, Position2D origin) {
+    float width = float(graphics.GetImageWidth(sprite.source));
+    float height = float(graphics.GetImageHeight(sprite.source));
+    graphics.ImageDraw(chunk, sprite.source, { 0, 0, width, height },
+                       { origin.x, origin.y, config.TileWidth, config.TileHeight }, Color2D::White());
+    const Position2D corners[] = {
+      { origin.x + halfWidth, origin.y },
+      { origin.x + config.TileWidth, origin.y + halfHeight },
+      { origin.x + halfWidth, origin.y + config.TileHeight },
+      { origin.x, origin.y + halfHeight }
+    };
+    for (int i = 0; i < 4; ++i) {
+      graphics.ImageDrawLineEx(chunk, corners[i], corners[(i + 1) % 4], 1.0f, Color2D::Black());
+    }
+  });
+  double drawMs = measure("ImageDraw (unscaled)", [&](const TileSprite& sprite, Position2D origin) {
+    float width = float(graphics.GetImageWidth(sprite.sprite));
+    float height = float(graphics.GetImageHeight(sprite.sprite));
+    graphics.ImageDraw(chunk, sprite.sprite, { 0, 0, width, height }, { origin.x, origin.y, width, height }, Color2D::White());
+  });
+  std::string blitName = std::string("ImageBlit (") + BlitRGBA8Variant() + ")";
+  double blitMs = measure(blitName.c_str(), [&](const TileSprite& sprite, Position2D origin) {
+    graphics.ImageBlit(chunk, sprite.sprite, origin);
+  });
+  if (blitMs > 0.0) {
+    std::cout << "Speedup over unscaled ImageDraw: " << std::setprecision(2) << drawMs / blitMs << "x" << std::endl;
+  }
+
+  graphics.UnloadImage(chunk);
+  ServiceLocator::Shutdown();
+  return 0;
+}
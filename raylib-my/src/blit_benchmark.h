@@ -0,0 +1,9 @@
+#pragma once
+
+class GameConfig;
+
+// Times drawing terrain tiles into a chunk-sized image: scaling the terrain
+// and drawing frame lines per tile, then the pre-composited sprite through
+// ImageDraw and through the ImageBlit kernel.
+// Runs on HeadlessGraphics, so no window is needed. Returns a process exit code.
+int RunBlitBenchmark(const GameConfig& config, int iterations);
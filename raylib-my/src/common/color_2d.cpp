@@ -54,6 +54,10 @@ Color2D Color2D::Magenta() {
   return Color2D(255, 0, 255, 255);
 }
 
+Color2D Color2D::Blank() {
+  return Color2D(0, 0, 0, 0);
+}
+
 Color2D Color2D::MenuBackground() {
   return Color2D(245, 245, 245, 255);
 }
@@ -21,6 +21,7 @@ public:
     static Color2D DarkGray();
     static Color2D LightGray();
     static Color2D Magenta();
+    static Color2D Blank();
     static Color2D MenuBackground();
     static Color2D MenuRowBackground();
     static Color2D MenuRowSelected();
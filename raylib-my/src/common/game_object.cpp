@@ -37,4 +37,10 @@ void GameObject::Render(RenderSystem& renderer) {
   }
 }
 
+void GameObject::Unload(RenderSystem& renderer) {
+  if (graphicsComponent) {
+    graphicsComponent->Unload(renderer);
+  }
+}
+
 GameObject::~GameObject() = default;
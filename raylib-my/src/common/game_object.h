@@ -19,6 +19,7 @@ public:
   virtual void HandleInput(InputSystem&, CollisionSystem&);
   virtual void Update(CollisionSystem&);
   virtual void Render(RenderSystem&);
+  virtual void Unload(RenderSystem&);
   virtual ~GameObject();
 
 protected:
@@ -1,5 +1,7 @@
 #include "grph_camera.h"
 
+#include <cmath>
+
 GrphCamera::GrphCamera():
   offset { 0.0f, 0.0f },
   target { 0.0f, 0.0f },
@@ -14,4 +16,15 @@ GrphCamera::GrphCamera(Position2D offset_, Position2D target_, float rotation_,
   zoom { zoom_ }
 {}
 
+Position2D GrphCamera::ScreenToWorld(Position2D screenPos) const {
+  float dx = (screenPos.x - offset.x) / zoom;
+  float dy = (screenPos.y - offset.y) / zoom;
+
+  float radians = -rotation * 3.14159265f / 180.0f;
+  float c = std::cos(radians);
+  float s = std::sin(radians);
+
+  return { target.x + dx * c - dy * s, target.y + dx * s + dy * c };
+}
+
 GrphCamera::~GrphCamera() = default;
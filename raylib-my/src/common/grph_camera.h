@@ -11,5 +11,6 @@ public:
 
   GrphCamera();
   GrphCamera(Position2D offset, Position2D target, float rotation, float zoom);
+  Position2D ScreenToWorld(Position2D screenPos) const;
   ~GrphCamera();
 };
@@ -0,0 +1,57 @@
+#include "iso_projection.h"
+
+#include <algorithm>
+#include <cmath>
+
+IsoProjection::IsoProjection(float tileWidth_, float tileHeight_):
+  tileWidth { tileWidth_ },
+  tileHeight { tileHeight_ }
+{}
+
+Position2D IsoProjection::GridToWorld(Position2D grid) const {
+  float sx = (grid.x - grid.y) * tileWidth * 0.5f;
+  float sy = (grid.x + grid.y) * tileHeight * 0.5f;
+
+  return { sx, sy };
+}
+
+Position2D IsoProjection::WorldToGrid(Position2D world) const {
+  float a = world.x / (tileWidth * 0.5f);
+  float b = world.y / (tileHeight * 0.5f);
+
+  return { (a + b) * 0.5f, (b - a) * 0.5f };
+}
+
+Position2D IsoProjection::WorldToTile(Position2D world) const {
+  Position2D grid = WorldToGrid(world);
+  return { std::floor(grid.x), std::floor(grid.y) };
+}
+
+TileRange IsoProjection::VisibleTileRange(const GrphCamera& camera, int screenWidth, int screenHeight,
+                                          int mapWidth, int mapHeight) const {
+  const Position2D corners[] = {
+    { 0.0f, 0.0f },
+    { float(screenWidth), 0.0f },
+    { 0.0f, float(screenHeight) },
+    { float(screenWidth), float(screenHeight) }
+  };
+
+  float minGx = INFINITY, minGy = INFINITY;
+  float maxGx = -INFINITY, maxGy = -INFINITY;
+  for (const Position2D& corner : corners) {
+    Position2D grid = WorldToGrid(camera.ScreenToWorld(corner));
+    minGx = std::min(minGx, grid.x);
+    minGy = std::min(minGy, grid.y);
+    maxGx = std::max(maxGx, grid.x);
+    maxGy = std::max(maxGy, grid.y);
+  }
+
+  // One tile of margin so diamonds clipped by the screen edge are still included
+  TileRange screenRange {
+    int(std::floor(minGx)) - 1,
+    int(std::floor(minGy)) - 1,
+    int(std::floor(maxGx)) + 2,
+    int(std::floor(maxGy)) + 2
+  };
+  return screenRange.Intersect(TileRange(0, 0, mapWidth, mapHeight));
+}
@@ -0,0 +1,21 @@
+#pragma once
+
+#include "grph_camera.h"
+#include "position_2d.h"
+#include "tile_range.h"
+
+// Isometric grid <-> world math shared by all RenderSystem backends
+class IsoProjection {
+public:
+  float tileWidth;
+  float tileHeight;
+
+  IsoProjection(float tileWidth, float tileHeight);
+
+  Position2D GridToWorld(Position2D grid) const;
+  // Fractional grid coordinates; floor them to get the tile index
+  Position2D WorldToGrid(Position2D world) const;
+  Position2D WorldToTile(Position2D world) const;
+  TileRange VisibleTileRange(const GrphCamera& camera, int screenWidth, int screenHeight,
+                             int mapWidth, int mapHeight) const;
+};
@@ -14,6 +14,7 @@ public:
 
   static constexpr Key KEY_A = 65;
   static constexpr Key KEY_D = 68;
+  static constexpr Key KEY_G = 71;
   static constexpr Key KEY_S = 83;
   static constexpr Key KEY_W = 87;
 };
@@ -0,0 +1,21 @@
+#include "mesh_handle.h"
+
+MeshHandle::MeshHandle(): id(0) {}
+
+MeshHandle::MeshHandle(uint32_t id): id(id) {}
+
+uint32_t MeshHandle::GetId() const {
+  return id;
+}
+
+bool MeshHandle::IsValid() const {
+  return id != 0;
+}
+
+bool MeshHandle::operator==(const MeshHandle& other) const {
+  return id == other.id;
+}
+
+bool MeshHandle::operator!=(const MeshHandle& other) const {
+  return id != other.id;
+}
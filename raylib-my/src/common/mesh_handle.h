@@ -0,0 +1,18 @@
+#pragma once
+
+#include <cstdint>
+
+class MeshHandle {
+public:
+  MeshHandle();
+  explicit MeshHandle(uint32_t id);
+
+  uint32_t GetId() const;
+  bool IsValid() const;
+
+  bool operator==(const MeshHandle& other) const;
+  bool operator!=(const MeshHandle& other) const;
+
+private:
+  uint32_t id;
+};
@@ -0,0 +1,18 @@
+#include "residency.h"
+
+#include "game_error.h"
+
+Residency ParseResidency(const std::string& name) {
+  if (name == "cpu") return Residency::Cpu;
+  if (name == "gpu") return Residency::Gpu;
+  if (name == "both") return Residency::Both;
+  throw GameError("Unknown residency: " + name);
+}
+
+bool KeepsCpuCopy(Residency residency) {
+  return residency != Residency::Gpu;
+}
+
+bool KeepsGpuCopy(Residency residency) {
+  return residency != Residency::Cpu;
+}
@@ -0,0 +1,12 @@
+#pragma once
+
+#include <string>
+
+// Where a resource keeps its pixels once it has been built: a CPU image, a GPU
+// texture, or both when it is still edited on the CPU after upload
+enum class Residency { Cpu, Gpu, Both };
+
+// Accepts the config spellings "cpu", "gpu" and "both"
+Residency ParseResidency(const std::string&);
+bool KeepsCpuCopy(Residency);
+bool KeepsGpuCopy(Residency);
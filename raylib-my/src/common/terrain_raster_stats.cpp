@@ -0,0 +1,11 @@
+#include "terrain_raster_stats.h"
+
+#include <iomanip>
+#include <sstream>
+
+std::string TerrainRasterStats::Describe() const {
+  std::ostringstream line;
+  line << std::fixed << std::setprecision(1)
+       << tiles << " tiles in " << rasterMs << " ms on " << threads << " threads";
+  return line.str();
+}
@@ -0,0 +1,13 @@
+#pragma once
+
+#include <string>
+
+// Cost of the first terrain raster pass, which bakes every visible chunk
+struct TerrainRasterStats {
+  int tiles = 0;
+  double rasterMs = 0.0;
+  int threads = 0;
+
+  // One line, e.g. "4096 tiles in 12.3 ms on 8 threads"
+  std::string Describe() const;
+};
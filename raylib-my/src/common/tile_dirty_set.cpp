@@ -0,0 +1,204 @@
+#include "tile_dirty_set.h"
+
+#include <algorithm>
+
+TileDirtySet::TileDirtySet(int width, int height, int size):
+  mapWidth { width },
+  mapHeight { height },
+  chunkSize { size },
+  chunksPerRow { (width + size - 1) / size },
+  wordsPerChunk { (size * size + 63) / 64 },
+  count { 0 },
+  unlisted { false }
+{
+  int chunkRows = (height + size - 1) / size;
+  bits.assign(static_cast<size_t>(chunksPerRow) * chunkRows * wordsPerChunk, 0);
+  listedBits.assign(bits.size(), 0);
+  chunkListed.assign(static_cast<size_t>(chunksPerRow) * chunkRows, 0);
+}
+
+size_t TileDirtySet::bitIndex(int x, int y) const {
+  int local = (y % chunkSize) * chunkSize + (x % chunkSize);
+  return static_cast<size_t>(ChunkIndex(x, y)) * wordsPerChunk * 64 + local;
+}
+
+void TileDirtySet::Mark(int x, int y) {
+  size_t bit = bitIndex(x, y);
+  uint64_t mask = uint64_t(1) << (bit % 64);
+  if (bits[bit / 64] & mask) return;
+
+  bits[bit / 64] |= mask;
+  ++count;
+  // A drained tile keeps its stale entry, so marking it again must not add a second one
+  if (!(listedBits[bit / 64] & mask)) {
+    listedBits[bit / 64] |= mask;
+    changes.push_back(y * mapWidth + x);
+  }
+
+  int chunk = ChunkIndex(x, y);
+  if (!chunkListed[chunk]) {
+    chunkListed[chunk] = 1;
+    dirtyChunks.push_back(chunk);
+  }
+
+  // Drained chunks leave stale entries behind; drop them before the list outgrows the set.
+  // Each pass removes more entries than the set holds, so the cost is amortized per mark.
+  if (changes.size() > 2 * static_cast<size_t>(count) + 1024) {
+    changes.erase(std::remove_if(changes.begin(), changes.end(), [this](int index) {
+      int x = index % mapWidth;
+      int y = index / mapWidth;
+      if (IsDirty(x, y)) return false;
+      size_t stale = bitIndex(x, y);
+      listedBits[stale / 64] &= ~(uint64_t(1) << (stale % 64));
+      return true;
+    }), changes.end());
+  }
+}
+
+void TileDirtySet::MarkAll() {
+  int chunkRows = (mapHeight + chunkSize - 1) / chunkSize;
+  for (int chunk = 0; chunk < chunksPerRow * chunkRows; ++chunk) {
+    int originX = (chunk % chunksPerRow) * chunkSize;
+    int originY = (chunk / chunksPerRow) * chunkSize;
+    int w = std::min(chunkSize, mapWidth - originX);
+    int h = std::min(chunkSize, mapHeight - originY);
+    uint64_t* words = &bits[static_cast<size_t>(chunk) * wordsPerChunk];
+    for (int ly = 0; ly < h; ++ly) {
+      for (int lx = 0; lx < w; ++lx) {
+        int local = ly * chunkSize + lx;
+        words[local / 64] |= uint64_t(1) << (local % 64);
+      }
+    }
+    if (!chunkListed[chunk]) {
+      chunkListed[chunk] = 1;
+      dirtyChunks.push_back(chunk);
+    }
+  }
+  count = mapWidth * mapHeight;
+  clearChanges();
+  unlisted = true;
+}
+
+void TileDirtySet::clearChanges() {
+  for (int index : changes) {
+    size_t bit = bitIndex(index % mapWidth, index / mapWidth);
+    listedBits[bit / 64] &= ~(uint64_t(1) << (bit % 64));
+  }
+  changes.clear();
+}
+
+void TileDirtySet::Clear() {
+  std::fill(bits.begin(), bits.end(), 0);
+  std::fill(chunkListed.begin(), chunkListed.end(), 0);
+  count = 0;
+  clearChanges();
+  dirtyChunks.clear();
+  unlisted = false;
+}
+
+bool TileDirtySet::IsDirty(int x, int y) const {
+  size_t bit = bitIndex(x, y);
+  return (bits[bit / 64] >> (bit % 64)) & 1;
+}
+
+bool TileDirtySet::clearBit(int x, int y) {
+  size_t bit = bitIndex(x, y);
+  uint64_t mask = uint64_t(1) << (bit % 64);
+  if (!(bits[bit / 64] & mask)) return false;
+
+  bits[bit / 64] &= ~mask;
+  --count;
+  return true;
+}
+
+bool TileDirtySet::IsEmpty() const {
+  return count == 0;
+}
+
+int TileDirtySet::Count() const {
+  return count;
+}
+
+size_t TileDirtySet::ChangeListSize() const {
+  return changes.size();
+}
+
+int TileDirtySet::ChunkSize() const {
+  return chunkSize;
+}
+
+int TileDirtySet::ChunkIndex(int x, int y) const {
+  return (y / chunkSize) * chunksPerRow + (x / chunkSize);
+}
+
+const std::vector<int>& TileDirtySet::DirtyChunks() const {
+  return dirtyChunks;
+}
+
+void TileDirtySet::unlistChunk(int chunk) {
+  chunkListed[chunk] = 0;
+  dirtyChunks.erase(std::find(dirtyChunks.begin(), dirtyChunks.end(), chunk));
+}
+
+void TileDirtySet::DrainChunk(int chunk, const TileVisitor& visitor) {
+  if (!chunkListed[chunk]) return;
+  unlistChunk(chunk);
+  drainBits(chunk, visitor);
+}
+
+void TileDirtySet::drainBits(int chunk, const TileVisitor& visitor) {
+  int originX = (chunk % chunksPerRow) * chunkSize;
+  int originY = (chunk / chunksPerRow) * chunkSize;
+  uint64_t* words = &bits[static_cast<size_t>(chunk) * wordsPerChunk];
+  for (int w = 0; w < wordsPerChunk; ++w) {
+    uint64_t word = words[w];
+    words[w] = 0;
+    while (word) {
+      int local = w * 64 + __builtin_ctzll(word);
+      word &= word - 1;
+      --count;
+      visitor(originX + local % chunkSize, originY + local / chunkSize);
+    }
+  }
+}
+
+void TileDirtySet::DrainChunks(const ChunkVisitor& visitor) {
+  for (int chunk : dirtyChunks) {
+    chunkListed[chunk] = 0;
+    uint64_t* words = &bits[static_cast<size_t>(chunk) * wordsPerChunk];
+    for (int w = 0; w < wordsPerChunk; ++w) {
+      count -= __builtin_popcountll(words[w]);
+      words[w] = 0;
+    }
+    visitor(chunk);
+  }
+  dirtyChunks.clear();
+  clearChanges();
+  unlisted = false;
+}
+
+void TileDirtySet::DrainAll(const TileVisitor& visitor) {
+  if (unlisted) {
+    for (int chunk : dirtyChunks) {
+      chunkListed[chunk] = 0;
+      drainBits(chunk, visitor);
+    }
+    dirtyChunks.clear();
+    clearChanges();
+    unlisted = false;
+    return;
+  }
+
+  for (int index : changes) {
+    int x = index % mapWidth;
+    int y = index / mapWidth;
+    if (clearBit(x, y)) {
+      visitor(x, y);
+    }
+  }
+  clearChanges();
+  for (int chunk : dirtyChunks) {
+    chunkListed[chunk] = 0;
+  }
+  dirtyChunks.clear();
+}
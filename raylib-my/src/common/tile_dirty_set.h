@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+// Changed tiles of one consumer. Bits are stored chunk-major, so a chunk's tiles
+// share a few adjacent words; a change list and a dirty-chunk list make every
+// drain cost O(changed) rather than O(map).
+class TileDirtySet {
+public:
+  using TileVisitor = std::function<void(int x, int y)>;
+
+  TileDirtySet(int mapWidth, int mapHeight, int chunkSize);
+
+  void Mark(int x, int y);
+  // Sets the bits directly, so the change list stays empty even on huge maps
+  void MarkAll();
+  void Clear();
+  bool IsDirty(int x, int y) const;
+  bool IsEmpty() const;
+  int Count() const;
+  // Entries in the change list, stale ones from drained chunks included
+  size_t ChangeListSize() const;
+
+  int ChunkSize() const;
+  int ChunkIndex(int x, int y) const;
+  // Chunks holding at least one dirty tile, in the order they first got dirty
+  const std::vector<int>& DirtyChunks() const;
+
+  // Visit and clear the dirty tiles of one chunk, row by row
+  void DrainChunk(int chunk, const TileVisitor&);
+  using ChunkVisitor = std::function<void(int chunk)>;
+  // Visit and clear every dirty chunk as a whole, for consumers that only rebuild chunks
+  void DrainChunks(const ChunkVisitor&);
+  // Visit and clear every dirty tile in the order it was marked; after MarkAll,
+  // chunk by chunk instead
+  void DrainAll(const TileVisitor&);
+
+private:
+  int mapWidth;
+  int mapHeight;
+  int chunkSize;
+  int chunksPerRow;
+  int wordsPerChunk;
+  int count;
+  // Some dirty tiles are missing from the change list (set by MarkAll)
+  bool unlisted;
+  std::vector<uint64_t> bits;
+  std::vector<int> changes;
+  // Same layout as bits; set while the tile has an entry in changes
+  std::vector<uint64_t> listedBits;
+  std::vector<int> dirtyChunks;
+  std::vector<uint8_t> chunkListed;
+
+  size_t bitIndex(int x, int y) const;
+  bool clearBit(int x, int y);
+  void unlistChunk(int chunk);
+  void clearChanges();
+  void drainBits(int chunk, const TileVisitor&);
+};
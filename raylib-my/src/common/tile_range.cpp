@@ -0,0 +1,42 @@
+#include "tile_range.h"
+
+#include <algorithm>
+
+TileRange::TileRange():
+  minX { 0 },
+  minY { 0 },
+  maxX { 0 },
+  maxY { 0 }
+{}
+
+TileRange::TileRange(int x0, int y0, int x1, int y1):
+  minX { x0 },
+  minY { y0 },
+  maxX { x1 },
+  maxY { y1 }
+{}
+
+bool TileRange::IsEmpty() const {
+  return minX >= maxX || minY >= maxY;
+}
+
+int TileRange::Count() const {
+  return IsEmpty() ? 0 : (maxX - minX) * (maxY - minY);
+}
+
+bool TileRange::Contains(int x, int y) const {
+  return x >= minX && x < maxX && y >= minY && y < maxY;
+}
+
+bool TileRange::Intersects(const TileRange& other) const {
+  return !Intersect(other).IsEmpty();
+}
+
+TileRange TileRange::Intersect(const TileRange& other) const {
+  return {
+    std::max(minX, other.minX),
+    std::max(minY, other.minY),
+    std::min(maxX, other.maxX),
+    std::min(maxY, other.maxY)
+  };
+}
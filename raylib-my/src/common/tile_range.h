@@ -0,0 +1,19 @@
+#pragma once
+
+// Half-open rectangle of grid tiles: [minX, maxX) x [minY, maxY)
+class TileRange {
+public:
+  int minX;
+  int minY;
+  int maxX;
+  int maxY;
+
+  TileRange();
+  TileRange(int minX, int minY, int maxX, int maxY);
+
+  bool IsEmpty() const;
+  int Count() const;
+  bool Contains(int x, int y) const;
+  bool Intersects(const TileRange&) const;
+  TileRange Intersect(const TileRange&) const;
+};
@@ -0,0 +1,98 @@
+#include "worker_pool.h"
+
+#include <algorithm>
+
+WorkerPool::WorkerPool(int threadCount):
+  job { nullptr },
+  jobCount { 0 },
+  generation { 0 },
+  nextIndex { 0 },
+  activeWorkers { 0 },
+  error { nullptr },
+  stopping { false }
+{
+  if (threadCount <= 0) {
+    threadCount = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+  }
+  for (int i = 1; i < threadCount; ++i) {
+    workers.emplace_back(&WorkerPool::workerLoop, this);
+  }
+}
+
+WorkerPool::~WorkerPool() {
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    stopping = true;
+  }
+  wake.notify_all();
+  for (std::thread& worker : workers) {
+    worker.join();
+  }
+}
+
+int WorkerPool::ThreadCount() const {
+  return static_cast<int>(workers.size()) + 1;
+}
+
+void WorkerPool::ParallelFor(int count, const std::function<void(int)>& task) {
+  if (count <= 0) return;
+  if (workers.empty() || count == 1) {
+    for (int i = 0; i < count; ++i) task(i);
+    return;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    job = &task;
+    jobCount = count;
+    nextIndex = 0;
+    error = nullptr;
+    activeWorkers = static_cast<int>(workers.size());
+    ++generation;
+  }
+  wake.notify_all();
+
+  runJob();
+
+  std::unique_lock<std::mutex> lock(mutex);
+  finished.wait(lock, [this] { return activeWorkers == 0; });
+  job = nullptr;
+  if (error) {
+    std::exception_ptr pending = error;
+    error = nullptr;
+    std::rethrow_exception(pending);
+  }
+}
+
+void WorkerPool::runJob() {
+  for (int i = nextIndex++; i < jobCount; i = nextIndex++) {
+    try {
+      (*job)(i);
+    } catch (...) {
+      std::lock_guard<std::mutex> lock(mutex);
+      if (!error) error = std::current_exception();
+      // Skip the remaining indices, the job is failing anyway
+      nextIndex = jobCount;
+    }
+  }
+}
+
+void WorkerPool::workerLoop() {
+  unsigned long seen = 0;
+  while (true) {
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+      wake.wait(lock, [this, seen] { return stopping || generation != seen; });
+      if (stopping) return;
+      seen = generation;
+    }
+
+    runJob();
+
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      --activeWorkers;
+    }
+    finished.notify_one();
+  }
+}
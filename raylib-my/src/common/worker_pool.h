@@ -0,0 +1,41 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Fixed set of threads for fork-join work. ParallelFor blocks until every
+// index has run; the calling thread takes part, so a pool of N threads
+// starts N - 1 workers. Not reentrant: tasks must not call ParallelFor.
+class WorkerPool {
+public:
+  // 0 picks the hardware concurrency
+  explicit WorkerPool(int threadCount);
+  WorkerPool(const WorkerPool&) = delete;
+  WorkerPool& operator=(const WorkerPool&) = delete;
+  ~WorkerPool();
+
+  int ThreadCount() const;
+  // Runs task(i) for every i in [0, count); rethrows the first task exception
+  void ParallelFor(int count, const std::function<void(int)>& task);
+
+private:
+  std::vector<std::thread> workers;
+  std::mutex mutex;
+  std::condition_variable wake;
+  std::condition_variable finished;
+  const std::function<void(int)>* job;
+  int jobCount;
+  unsigned long generation;
+  std::atomic<int> nextIndex;
+  int activeWorkers;
+  std::exception_ptr error;
+  bool stopping;
+
+  void workerLoop();
+  void runJob();
+};
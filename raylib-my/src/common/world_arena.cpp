@@ -0,0 +1,63 @@
+#include "world_arena.h"
+
+#include <cstdint>
+
+#include "game_error.h"
+
+namespace {
+
+size_t paddingFor(const std::byte* address, size_t alignment) {
+  return (alignment - reinterpret_cast<uintptr_t>(address) % alignment) % alignment;
+}
+
+}
+
+WorldArena::WorldArena(size_t blockSize_):
+  blockSize { blockSize_ },
+  blocks { },
+  cursor { nullptr },
+  remaining { 0 },
+  stats { }
+{
+  if (blockSize == 0) {
+    throw GameError("World arena block size must be positive");
+  }
+}
+
+void* WorldArena::Allocate(size_t bytes, size_t alignment) {
+  if (bytes == 0) bytes = 1;
+  ++stats.allocations;
+  stats.bytesUsed += bytes;
+
+  // Requests larger than half a block get a block of their own, so a column of a
+  // big world never strands the tail of the current block
+  if (bytes + alignment > blockSize / 2) {
+    std::byte* data = addBlock(bytes + alignment);
+    return data + paddingFor(data, alignment);
+  }
+
+  size_t padding = cursor ? paddingFor(cursor, alignment) : 0;
+  if (!cursor || padding + bytes > remaining) {
+    cursor = addBlock(blockSize);
+    remaining = blockSize;
+    padding = paddingFor(cursor, alignment);
+  }
+  std::byte* result = cursor + padding;
+  cursor = result + bytes;
+  remaining -= padding + bytes;
+  return result;
+}
+
+const WorldArenaStats& WorldArena::Stats() const {
+  return stats;
+}
+
+// Blocks are left uninitialized; every user writes its memory before reading it
+std::byte* WorldArena::addBlock(size_t size) {
+  blocks.push_back({ std::unique_ptr<std::byte[]>(new std::byte[size]), size });
+  ++stats.blocks;
+  stats.bytesReserved += size;
+  return blocks.back().data.get();
+}
+
+WorldArena::~WorldArena() = default;
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+struct WorldArenaStats {
+  size_t allocations = 0;
+  size_t blocks = 0;
+  size_t bytesUsed = 0;
+  size_t bytesReserved = 0;
+};
+
+// Bump-pointer arena for data that lives exactly as long as one world. Nothing is
+// freed individually: the blocks go back in one pass when the arena is destroyed,
+// so only use it for storage that is sized once and never shrinks.
+class WorldArena {
+public:
+  static constexpr size_t DefaultBlockSize = 1 << 20;
+
+  explicit WorldArena(size_t blockSize = DefaultBlockSize);
+  WorldArena(const WorldArena&) = delete;
+  WorldArena& operator=(const WorldArena&) = delete;
+
+  void* Allocate(size_t bytes, size_t alignment);
+  const WorldArenaStats& Stats() const;
+  ~WorldArena();
+
+private:
+  struct Block {
+    std::unique_ptr<std::byte[]> data;
+    size_t size;
+  };
+
+  size_t blockSize;
+  std::vector<Block> blocks;
+  // Free tail of the block small requests are bumped from
+  std::byte* cursor;
+  size_t remaining;
+  WorldArenaStats stats;
+
+  std::byte* addBlock(size_t size);
+};
@@ -0,0 +1,14 @@
+#include "world_build_stats.h"
+
+#include <iomanip>
+#include <sstream>
+
+std::string WorldBuildStats::Describe() const {
+  constexpr double kMiB = 1024.0 * 1024.0;
+  std::ostringstream line;
+  line << std::fixed << std::setprecision(1)
+       << tiles << " tiles " << tileBytes / kMiB << " MiB in " << buildMs << " ms, "
+       << "arena " << arena.allocations << " allocations in " << arena.blocks << " blocks "
+       << arena.bytesReserved / kMiB << " MiB";
+  return line.str();
+}
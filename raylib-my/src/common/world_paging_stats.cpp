@@ -0,0 +1,12 @@
+#include "world_paging_stats.h"
+
+#include <sstream>
+
+std::string WorldPagingStats::Describe() const {
+  std::ostringstream line;
+  line << residentPages << "/" << budgetPages << " pages of " << chunkSize << "x" << chunkSize
+       << " resident (peak " << peakResidentPages << "), "
+       << pageIns << " in (" << pageInsFromFile << " from file), "
+       << evictions << " evicted, " << writeBacks << " written back";
+  return line.str();
+}
@@ -0,0 +1,21 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+// Page traffic of a paged world since it was built
+struct WorldPagingStats {
+  int chunkSize = 0;
+  int chunks = 0;
+  int residentPages = 0;
+  int peakResidentPages = 0;
+  int budgetPages = 0;
+  size_t pageBytes = 0;
+  long long pageIns = 0;
+  long long pageInsFromFile = 0;
+  long long evictions = 0;
+  long long writeBacks = 0;
+
+  // One line, e.g. "412/8192 pages of 64x64 resident (peak 530), 1204 in (88 from file), 792 evicted, 91 written back"
+  std::string Describe() const;
+};
@@ -7,6 +7,7 @@
 #include <nlohmann/json.hpp>
 
 #include "../common/json_require.h"
+#include "../common/residency.h"
 
 using nlohmann::json;
 
@@ -43,6 +44,7 @@ GameConfig GameConfig::LoadFromJson(const std::string& json_text) {
 
   const json& display = JsonRequire::Object(j, "display", throw_runtime);
   const json& world = JsonRequire::Object(j, "world", throw_runtime);
+  const json& render = JsonRequire::Object(j, "render", throw_runtime);
 
   GameConfig config;
   config.ScreenWidth = JsonRequire::Field<int>(display, "screenWidth", throw_runtime);
@@ -55,6 +57,17 @@ GameConfig GameConfig::LoadFromJson(const std::string& json_text) {
   config.TileHeight = JsonRequire::Field<float>(world, "tileHeight", throw_runtime);
   config.WorldWidth = JsonRequire::Field<int>(world, "worldWidth", throw_runtime);
   config.WorldHeight = JsonRequire::Field<int>(world, "worldHeight", throw_runtime);
+  config.PagedTiles = JsonRequire::Field<bool>(world, "pagedTiles", throw_runtime);
+  config.PageChunkSize = JsonRequire::Field<int>(world, "pageChunkSize", throw_runtime);
+  config.PageBudgetMB = JsonRequire::Field<int>(world, "pageBudgetMB", throw_runtime);
+  config.PageFile = JsonRequire::Field<std::string>(world, "pageFile", throw_runtime);
+
+  config.RenderMode = JsonRequire::Field<std::string>(render, "mode", throw_runtime);
+  config.ZoomMin = JsonRequire::Field<float>(render, "zoomMin", throw_runtime);
+  config.CommandBuffer = JsonRequire::Field<bool>(render, "commandBuffer", throw_runtime);
+  config.RasterThreads = JsonRequire::Field<int>(render, "rasterThreads", throw_runtime);
+  config.TerrainResidency = JsonRequire::Field<std::string>(render, "terrainResidency", throw_runtime);
+  config.ChunkResidency = JsonRequire::Field<std::string>(render, "chunkResidency", throw_runtime);
 
   config.Validate();
   return config;
@@ -73,7 +86,19 @@ std::string GameConfig::ToJson() const {
     {"tileWidth", TileWidth},
     {"tileHeight", TileHeight},
     {"worldWidth", WorldWidth},
-    {"worldHeight", WorldHeight}
+    {"worldHeight", WorldHeight},
+    {"pagedTiles", PagedTiles},
+    {"pageChunkSize", PageChunkSize},
+    {"pageBudgetMB", PageBudgetMB},
+    {"pageFile", PageFile}
+  };
+  j["render"] = {
+    {"mode", RenderMode},
+    {"zoomMin", ZoomMin},
+    {"commandBuffer", CommandBuffer},
+    {"rasterThreads", RasterThreads},
+    {"terrainResidency", TerrainResidency},
+    {"chunkResidency", ChunkResidency}
   };
   return j.dump(2);
 }
@@ -94,4 +119,32 @@ void GameConfig::Validate() const {
   if (WorldWidth <= 0 || WorldHeight <= 0) {
     throw std::runtime_error("World dimensions must be positive.");
   }
+  if (PageChunkSize < 8 || PageChunkSize > 256 || (PageChunkSize & (PageChunkSize - 1)) != 0) {
+    throw std::runtime_error("Page chunk size must be a power of two in [8, 256].");
+  }
+  if (PageBudgetMB <= 0) {
+    throw std::runtime_error("Page budget must be positive.");
+  }
+  if (PagedTiles && PageFile.empty()) {
+    throw std::runtime_error("Page file must not be empty when tiles are paged.");
+  }
+  if (RenderMode != "image" && RenderMode != "atlas" && RenderMode != "mesh") {
+    throw std::runtime_error("Render mode must be one of: image, atlas, mesh.");
+  }
+  // The image renderer allocates a raster image for every chunk of the map up front
+  if (PagedTiles && RenderMode == "image") {
+    throw std::runtime_error("Paged tiles need the atlas or mesh render mode.");
+  }
+  if (ZoomMin <= 0.0f || ZoomMin > 1.0f) {
+    throw std::runtime_error("Minimum zoom must be in (0, 1].");
+  }
+  if (RasterThreads < 0) {
+    throw std::runtime_error("Raster threads must not be negative.");
+  }
+  // ParseResidency throws on unknown names
+  ParseResidency(TerrainResidency);
+  // Chunks are drawn as textures, so they always need the GPU side
+  if (!KeepsGpuCopy(ParseResidency(ChunkResidency))) {
+    throw std::runtime_error("Chunk residency must be one of: gpu, both.");
+  }
 }
@@ -18,6 +18,24 @@ public:
   // World settings
   int WorldWidth = 60;
   int WorldHeight = 80;
+  // Keep only recently used tile chunks in memory, paging the rest in from the
+  // world source and out to PageFile under PageBudgetMB
+  bool PagedTiles = false;
+  int PageChunkSize = 64;
+  int PageBudgetMB = 256;
+  std::string PageFile = "world_pages.bin";
+
+  // Render settings
+  std::string RenderMode = "image";
+  float ZoomMin = 0.125f;
+  bool CommandBuffer = false;
+  // Worker threads for CPU terrain rasterization, 0 = one per hardware thread
+  int RasterThreads = 0;
+  // Residency of per-terrain images once sprites and atlas are built: cpu, gpu or both
+  std::string TerrainResidency = "both";
+  // Residency of rasterized world chunks: gpu drops the CPU image after upload and
+  // re-rasterizes the whole chunk on its next edit, both keeps incremental updates
+  std::string ChunkResidency = "both";
 
   static GameConfig LoadFromFile(const std::string& path);
   void SaveToFile(const std::string& path) const;
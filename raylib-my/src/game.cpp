@@ -1,16 +1,21 @@
 #include <cmath>
 #include <exception>
 #include <iostream>
+#include <memory>
+#include <string>
 
 #include "common/game_error.h"
 #include "config/game_config.h"
 #include "menus/factory.h"
+#include "graphics/command_buffer_renderer.h"
 #include "graphics/raylib_graphics.h"
 #include "graphics/resources_system.h"
+#include "blit_benchmark.h"
 #include "game_interface.h"
+#include "headless_benchmark.h"
 #include "services/service_locator.h"
 
-int main(void) {
+int main(int argc, char** argv) {
   GameConfig config;
   try {
     config = GameConfig::LoadFromFile("config/config.json");
@@ -19,6 +24,38 @@ int main(void) {
     return 1;
   }
 
+  // --headless [frames] [--dump frame.png]: scripted run without a window, prints timings
+  if (argc > 1 && std::string(argv[1]) == "--headless") {
+    int frames = 600;
+    std::string dumpPath;
+    for (int i = 2; i < argc; ++i) {
+      std::string arg = argv[i];
+      if (arg == "--dump" && i + 1 < argc) {
+        dumpPath = argv[++i];
+      } else {
+        try {
+          frames = std::stoi(arg);
+        } catch (const std::exception&) {
+          std::cerr << "Unknown headless argument: " << arg << std::endl;
+          return 1;
+        }
+      }
+    }
+    return RunHeadlessBenchmark(config, frames, dumpPath);
+  }
+
+  // --bench-blit [iterations]: tile compositing microbenchmark
+  if (argc > 1 && std::string(argv[1]) == "--bench-blit") {
+    int iterations = 20;
+    try {
+      if (argc > 2) iterations = std::stoi(argv[2]);
+    } catch (const std::exception&) {
+      std::cerr << "Invalid iteration count: " << argv[2] << std::endl;
+      return 1;
+    }
+    return RunBlitBenchmark(config, iterations);
+  }
+
   ServiceLocator::Initialize(config);
   RaylibGraphics graphics {
     config.ScreenWidth,
@@ -34,14 +71,29 @@ int main(void) {
 
   ServiceLocator::LoadResources(static_cast<ResourcesSystem&>(graphics));
 
+  std::unique_ptr<CommandBufferRenderer> commandBuffer;
+  if (config.CommandBuffer) {
+    commandBuffer = std::make_unique<CommandBufferRenderer>(static_cast<RenderSystem&>(graphics));
+  }
+  RenderSystem& renderer = commandBuffer ? *commandBuffer : static_cast<RenderSystem&>(graphics);
+
   while (!graphics.Done()) {
     interface.HandleInput(static_cast<InputSystem&>(graphics), static_cast<CollisionSystem&>(graphics));
     interface.Update(static_cast<CollisionSystem&>(graphics));
-    graphics.BeginDrawing();
-      interface.Render(static_cast<RenderSystem&>(graphics));
-    graphics.EndDrawing();
+    renderer.BeginDrawing();
+      interface.Render(renderer);
+      if (commandBuffer) {
+        const RenderCommandStats& stats = commandBuffer->LastFrameStats();
+        std::string line = "Commands: " + std::to_string(stats.commandsRecorded) + "  Batches: " + std::to_string(stats.batchesEmitted);
+        renderer.SetLayer(RenderLayer::Debug);
+        renderer.DrawText(line.c_str(), { 10.0f, 32.0f }, 16, Color2D::DarkGray());
+      }
+    renderer.EndDrawing();
   }
 
+  // The command buffer defers unloads to the next frame, so release straight on the backend
+  interface.Unload(static_cast<RenderSystem&>(graphics));
+  ServiceLocator::UnloadResources(static_cast<ResourcesSystem&>(graphics));
   ServiceLocator::Shutdown();
 
   return 0;
@@ -3,8 +3,9 @@
 #include "graphics_components/component.h"
 #include "update_components/component.h"
 
-GameCamera::GameCamera(std::unique_ptr<InputComponent> inp, std::unique_ptr<GraphicsComponent> grph, std::unique_ptr<UpdateComponent> upd):
+GameCamera::GameCamera(std::unique_ptr<InputComponent> inp, std::unique_ptr<GraphicsComponent> grph, std::unique_ptr<UpdateComponent> upd, float zoomMin):
   GameObject(std::move(inp), std::move(grph), std::move(upd)),
+  ZOOM_MIN { zoomMin },
   offset { 0.0f, 0.0f },
   target { 0.0f, 0.0f },
   rotation { 0 },
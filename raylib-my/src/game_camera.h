@@ -12,7 +12,7 @@ class GameCamera: public GameObject {
 public:
   const float ZOOM_SPEED = 0.1f;
   const float MOVE_SPEED = 3.0f;
-  const float ZOOM_MIN = 0.5f;
+  const float ZOOM_MIN;
   const float ZOOM_MAX = 3.0f;
 
   Position2D offset;      // Camera offset (displacement from target)
@@ -21,7 +21,7 @@ public:
   float zoom;             // Camera zoom (scaling), should be 1.0f by default
   float pendingWheel;
 
-  GameCamera(std::unique_ptr<InputComponent> inp, std::unique_ptr<GraphicsComponent> grph, std::unique_ptr<UpdateComponent> upd);
+  GameCamera(std::unique_ptr<InputComponent> inp, std::unique_ptr<GraphicsComponent> grph, std::unique_ptr<UpdateComponent> upd, float zoomMin);
   void UpdateFromGrphCamera(const GrphCamera& grphCamera);
   ~GameCamera();
 };
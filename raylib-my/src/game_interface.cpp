@@ -5,7 +5,6 @@
 #include "graphics/collision_system.h"
 #include "graphics/input_system.h"
 #include "graphics/render_system.h"
-#include "common/game_error.h"
 #include "world_persistence/world_persistence_service.h"
 
 // TODO: Doesn't follow component pattern, consider to refactor
@@ -13,7 +12,8 @@ GameInterface::GameInterface(int w, int h):
   screenWidth { w },
   screenHeight { h },
   gameWorld { nullptr },
-  currentMenu { nullptr }
+  currentMenu { nullptr },
+  minimap { nullptr }
 {
   gameWorld = WorldPersistenceService::CreateFromServices().LoadOrGenerate();
 
@@ -25,13 +25,8 @@ GameInterface::GameInterface(int w, int h):
   RebuildAreas();
 };
 
-void GameInterface::ReplaceWorld(std::unique_ptr<GameWorld> new_world) {
-  if (!new_world) {
-    throw GameError("Cannot replace world with null instance");
-  }
-
-  gameWorld = std::move(new_world);
-  RebuildAreas();
+const GameWorld& GameInterface::World() const {
+  return *gameWorld;
 }
 
 void GameInterface::AddArea(GameObject& obj, Rectangle2D pos, int priority) {
@@ -51,6 +46,14 @@ void GameInterface::RebuildAreas() {
 
   AddArea(*gameWorld, { 0, 0, float(screenWidth), float(screenHeight) }, 0);
   AddArea(*currentMenu, currentMenu->Position, 1);
+
+  // The minimap holds on to the world and its dirty consumer, so it is rebuilt with it
+  float minimapSize = 200.0f;
+  float margin = 10.0f;
+  minimap = MenuFactory::CreateMinimap({
+    margin, float(screenHeight) - margin - minimapSize, minimapSize, minimapSize
+  }, *gameWorld);
+  AddArea(*minimap, minimap->Position, 2);
 }
 
 void GameInterface::HandleInput(InputSystem& input, CollisionSystem& collision) {
@@ -79,4 +82,10 @@ void GameInterface::Render(RenderSystem& renderer) {
   }
 }
 
+void GameInterface::Unload(RenderSystem& renderer) {
+  gameWorld->Unload(renderer);
+  currentMenu->Unload(renderer);
+  minimap->Unload(renderer);
+}
+
 GameInterface::~GameInterface() = default;
@@ -10,10 +10,11 @@
 class GameInterface: public GameObject {
 public:
   GameInterface(int, int);
-  void ReplaceWorld(std::unique_ptr<GameWorld>);
+  const GameWorld& World() const;
   virtual void HandleInput(InputSystem&, CollisionSystem&) override;
   virtual void Update(CollisionSystem&) override;
   virtual void Render(RenderSystem&) override;
+  virtual void Unload(RenderSystem&) override;
 
   ~GameInterface();
 
@@ -24,6 +25,7 @@ private:
   std::vector<size_t> sortedIndices;
   std::unique_ptr<GameWorld> gameWorld;
   std::unique_ptr<Menu> currentMenu;
+  std::unique_ptr<Minimap> minimap;
 
   void AddArea(GameObject&, Rectangle2D, int);
   void RebuildAreas();
@@ -1,4 +1,6 @@
 #include "game_world.h"
+#include <algorithm>
+#include <chrono>
 #include <string>
 #include <utility>
 
@@ -14,47 +16,285 @@ GameWorld::GameWorld(
   std::unique_ptr<InputComponent> inp,
   std::unique_ptr<GraphicsComponent> rnd,
   std::unique_ptr<UpdateComponent> upd,
-  TileProvider tilesProvider
+  TileProvider tilesProvider,
+  float zoomMin,
+  const WorldPagingOptions& paging
 ):
   GameObject(std::move(inp), std::move(rnd), std::move(upd)),
   MapWidth { w },
   MapHeight { h },
-  grid { }
+  arena { },
+  tiles { w, h, arena, paging },
+  buildMs { 0.0 },
+  rasterStats { },
+  visibleRange { 0, 0, w, h },
+  gridVisible { true },
+  gridColor { Color2D::Black() }
 {
   camera = std::make_unique<GameCamera>(
     std::make_unique<CameraInputComponent>(),
     std::make_unique<CameraGraphicsComponent>(),
-    std::make_unique<CameraUpdateComponent>()
+    std::make_unique<CameraUpdateComponent>(),
+    zoomMin
   );
 
-  InitializeGrid(std::move(tilesProvider));
+  tiles.SetPageListeners(
+    [this](int chunk) { systems.ChunkLoaded(tiles, chunk); },
+    [this](int chunk) { systems.ChunkUnloaded(tiles, chunk); });
+
+  auto start = std::chrono::steady_clock::now();
+  if (tiles.IsPaged()) {
+    tiles.SetTileSource(std::move(tilesProvider));
+  } else {
+    InitializeGrid(std::move(tilesProvider));
+  }
+  buildMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
 };
 
 void GameWorld::InitializeGrid(TileProvider tilesProvider) {
   for (int y = 0; y < MapHeight; ++y) {
     for (int x = 0; x < MapWidth; ++x) {
-      std::unique_ptr<WorldTile> tile = tilesProvider(x, y);
-      if (!tile) {
-        throw GameError("Tile provider returned null tile for index x: " + std::to_string(x) + ", y: " + std::to_string(y));
+      WorldTileInit tile = tilesProvider(x, y);
+      if (!tile.terrain) {
+        throw GameError("Tile provider returned no terrain for index x: " + std::to_string(x) + ", y: " + std::to_string(y));
+      }
+
+      int index = y * MapWidth + x;
+      tiles.SetTerrain(index, *tile.terrain);
+      if (tile.decoration) {
+        tiles.SetDecoration(index, tile.decoration->Type, tile.decorationState);
+      }
+      if (tile.resource) {
+        tiles.SetResource(index, tile.resource->Type, tile.resourceVolume);
+      }
+      if (tiles.HasOverlay(index)) {
+        overlayOrder.push_back(index);
       }
-      grid.push_back(std::move(tile));
     }
   }
+
+  std::sort(overlayOrder.begin(), overlayOrder.end(),
+    [this](int i1, int i2) { return overlayBefore(i1, i2); });
+}
+
+bool GameWorld::overlayBefore(int index1, int index2) const {
+  int x1 = index1 % MapWidth, y1 = index1 / MapWidth;
+  int x2 = index2 % MapWidth, y2 = index2 / MapWidth;
+  if (x1 + y1 != x2 + y2) return x1 + y1 < x2 + y2;
+  return x1 < x2;
+}
+
+// Single sorted insert or erase, so tile edits never re-sort the whole overlay
+void GameWorld::updateOverlayOrder(int index) {
+  if (tiles.IsPaged()) return;
+  bool hasOverlay = tiles.HasOverlay(index);
+  auto it = std::lower_bound(overlayOrder.begin(), overlayOrder.end(), index,
+    [this](int i1, int i2) { return overlayBefore(i1, i2); });
+  bool listed = it != overlayOrder.end() && *it == index;
+
+  if (hasOverlay && !listed) {
+    overlayOrder.insert(it, index);
+  } else if (!hasOverlay && listed) {
+    overlayOrder.erase(it);
+  }
+}
+
+void GameWorld::checkBounds(int x, int y) const {
+  if (x < 0 || y < 0 || x >= MapWidth || y >= MapHeight) {
+    throw GameError("Grid possition overflow");
+  }
+}
+
+void GameWorld::SetTileTerrain(int x, int y, const WorldTileTerrainType& type) {
+  checkBounds(x, y);
+  tiles.SetTerrain(y * MapWidth + x, type);
+  tileChanged(x, y);
+}
+
+void GameWorld::SetTileDecoration(int x, int y, const WorldTileDecoration* decoration, uint32_t state) {
+  checkBounds(x, y);
+  if (decoration) {
+    tiles.SetDecoration(y * MapWidth + x, decoration->Type, state);
+  } else {
+    tiles.ClearDecoration(y * MapWidth + x);
+  }
+  updateOverlayOrder(y * MapWidth + x);
+  tileChanged(x, y);
+}
+
+void GameWorld::SetTileResource(int x, int y, const WorldTileResource* resource, uint32_t volume) {
+  checkBounds(x, y);
+  if (resource) {
+    tiles.SetResource(y * MapWidth + x, resource->Type, volume);
+  } else {
+    tiles.ClearResource(y * MapWidth + x);
+  }
+  updateOverlayOrder(y * MapWidth + x);
+  tileChanged(x, y);
+}
+
+// The resource itself stays, so the overlay order is unchanged
+void GameWorld::SetTileResourceVolume(int x, int y, uint32_t volume) {
+  checkBounds(x, y);
+  tiles.SetResourceVolume(y * MapWidth + x, volume);
+  tileChanged(x, y);
+}
+
+void GameWorld::MarkTileDirty(int x, int y) {
+  checkBounds(x, y);
+  for (auto& consumer : dirtyConsumers) {
+    consumer->Mark(x, y);
+  }
+}
+
+void GameWorld::tileChanged(int x, int y) {
+  MarkTileDirty(x, y);
+  systems.TileChanged(tiles, y * MapWidth + x);
+}
+
+void GameWorld::RegisterSystem(std::unique_ptr<TileSystem> system) {
+  systems.Register(std::move(system), tiles);
+}
+
+void GameWorld::UpdateSystems() {
+  systems.Run(*this, tiles);
+}
+
+const TileSystemRegistry& GameWorld::Systems() const {
+  return systems;
+}
+
+GameWorld::DirtyConsumer GameWorld::RegisterDirtyConsumer(int chunkSize) {
+  if (chunkSize <= 0) {
+    throw GameError("Dirty consumer chunk size must be positive");
+  }
+  auto consumer = std::make_unique<TileDirtySet>(MapWidth, MapHeight, chunkSize);
+  consumer->MarkAll();
+  dirtyConsumers.push_back(std::move(consumer));
+  return static_cast<DirtyConsumer>(dirtyConsumers.size() - 1);
 }
 
-WorldTile& GameWorld::operator[](Position2D pos) {
+TileDirtySet& GameWorld::DirtyTiles(DirtyConsumer consumer) {
+  if (consumer < 0 || consumer >= static_cast<int>(dirtyConsumers.size())) {
+    throw GameError("Unknown dirty consumer " + std::to_string(consumer));
+  }
+  return *dirtyConsumers[consumer];
+}
+
+WorldTileView GameWorld::operator[](Position2D pos) const {
   if (pos.x >= MapWidth || pos.y >= MapHeight) {
     throw GameError("Grid possition overflow");
   }
-  return *grid[floor(pos.y) * MapWidth + floor(pos.x)];
+  return WorldTileView(tiles, static_cast<int>(floor(pos.y) * MapWidth + floor(pos.x)));
 }
 
-WorldTile& GameWorld::GetTile(int index) {
-  return *grid[index];
+WorldTileView GameWorld::GetTile(int index) const {
+  return WorldTileView(tiles, index);
+}
+
+const WorldTileStorage& GameWorld::Tiles() const {
+  return tiles;
 }
 
 GameCamera& GameWorld::GetCamera() {
   return *camera;
 }
 
+WorldBuildStats GameWorld::BuildStats() const {
+  WorldBuildStats stats;
+  stats.tiles = tiles.Size();
+  stats.tileBytes = tiles.ByteSize();
+  stats.buildMs = buildMs;
+  stats.arena = arena.Stats();
+  return stats;
+}
+
+WorldPagingStats GameWorld::PagingStats() const {
+  return tiles.PagingStats();
+}
+
+TerrainRasterStats GameWorld::RasterStats() const {
+  return rasterStats;
+}
+
+void GameWorld::RecordRasterStats(const TerrainRasterStats& stats) {
+  rasterStats = stats;
+}
+
+void GameWorld::BeginFrame() {
+  tiles.BeginFrame();
+}
+
+const TileRange& GameWorld::VisibleRange() const {
+  return visibleRange;
+}
+
+void GameWorld::SetVisibleRange(const TileRange& range) {
+  visibleRange = range.Intersect(TileRange(0, 0, MapWidth, MapHeight));
+}
+
+void GameWorld::ForEachVisibleTile(const TileVisitor& visitor) {
+  for (int y = visibleRange.minY; y < visibleRange.maxY; ++y) {
+    for (int x = visibleRange.minX; x < visibleRange.maxX; ++x) {
+      visitor(WorldTileView(tiles, y * MapWidth + x));
+    }
+  }
+}
+
+void GameWorld::ForEachVisibleOverlayTile(const TileVisitor& visitor) {
+  if (visibleRange.IsEmpty()) return;
+  if (tiles.IsPaged()) {
+    forEachVisibleOverlayTileScan(visitor);
+    return;
+  }
+
+  // Sorted by depth, then x, so each diagonal's visible x-range is one contiguous run;
+  // a binary search per diagonal keeps the cost bounded by the view, not the map width
+  int minDepth = visibleRange.minX + visibleRange.minY;
+  int maxDepth = (visibleRange.maxX - 1) + (visibleRange.maxY - 1);
+  auto before = [this](int index1, int index2) { return overlayBefore(index1, index2); };
+  auto it = overlayOrder.begin();
+  for (int depth = minDepth; depth <= maxDepth; ++depth) {
+    int fromX = std::max(visibleRange.minX, depth - (visibleRange.maxY - 1));
+    int toX = std::min(visibleRange.maxX - 1, depth - visibleRange.minY);
+    it = std::lower_bound(it, overlayOrder.end(), (depth - fromX) * MapWidth + fromX, before);
+    for (; it != overlayOrder.end(); ++it) {
+      int x = *it % MapWidth;
+      if (x + *it / MapWidth != depth || x > toX) break;
+      visitor(WorldTileView(tiles, *it));
+    }
+  }
+}
+
+// Walks the view one diagonal at a time, which is the same painter's order
+// without a world-wide list; the visible tiles are read for the terrain anyway
+void GameWorld::forEachVisibleOverlayTileScan(const TileVisitor& visitor) {
+  int minDepth = visibleRange.minX + visibleRange.minY;
+  int maxDepth = (visibleRange.maxX - 1) + (visibleRange.maxY - 1);
+  for (int depth = minDepth; depth <= maxDepth; ++depth) {
+    int fromX = std::max(visibleRange.minX, depth - (visibleRange.maxY - 1));
+    int toX = std::min(visibleRange.maxX - 1, depth - visibleRange.minY);
+    for (int x = fromX; x <= toX; ++x) {
+      int index = (depth - x) * MapWidth + x;
+      if (tiles.HasOverlay(index)) visitor(WorldTileView(tiles, index));
+    }
+  }
+}
+
+bool GameWorld::GridVisible() const {
+  return gridVisible;
+}
+
+void GameWorld::ToggleGrid() {
+  gridVisible = !gridVisible;
+}
+
+Color2D GameWorld::GridColor() const {
+  return gridColor;
+}
+
+void GameWorld::SetGridColor(Color2D color) {
+  gridColor = color;
+}
+
 GameWorld::~GameWorld() = default;
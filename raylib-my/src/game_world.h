@@ -5,35 +5,99 @@
 #include <functional>
 
 #include "graphics/render_system.h"
+#include "common/color_2d.h"
 #include "common/game_error.h"
 #include "common/game_object.h"
+#include "common/terrain_raster_stats.h"
+#include "common/tile_dirty_set.h"
+#include "common/tile_range.h"
+#include "common/world_arena.h"
+#include "common/world_build_stats.h"
+#include "common/world_paging_stats.h"
 #include "game_camera.h"
 #include "input_components/component.h"
 #include "graphics_components/component.h"
-#include "world_tiles/tile.h"
+#include "world_tiles/tile_view.h"
+#include "world_systems/tile_system_registry.h"
 
 class GameWorld: public GameObject {
 public:
   int MapWidth;
   int MapHeight;
 
-  using TileProvider = std::function<std::unique_ptr<WorldTile>(int x, int y)>;
+  using TileProvider = std::function<WorldTileInit(int x, int y)>;
+  using TileVisitor = std::function<void(const WorldTileView&)>;
+  using DirtyConsumer = int;
 
   GameWorld(const GameWorld&) = delete;
   GameWorld& operator=(const GameWorld&) = delete;
   GameWorld(GameWorld&&) = delete;
   GameWorld& operator=(GameWorld&&) = delete;
 
+  // A paged world keeps the provider and asks it for chunks as they are first
+  // visited, so the provider must stay valid for the world's lifetime.
+  // zoomMin is the camera's lowest zoom.
   GameWorld(int, int, std::unique_ptr<InputComponent>, std::unique_ptr<GraphicsComponent>,
-            std::unique_ptr<UpdateComponent>, TileProvider);
+            std::unique_ptr<UpdateComponent>, TileProvider, float zoomMin,
+            const WorldPagingOptions& = WorldPagingOptions());
 
-  WorldTile& operator[](Position2D);
-  WorldTile& GetTile(int);
+  WorldTileView operator[](Position2D) const;
+  WorldTileView GetTile(int) const;
+  const WorldTileStorage& Tiles() const;
   GameCamera& GetCamera();
+  WorldBuildStats BuildStats() const;
+  WorldPagingStats PagingStats() const;
+  // Filled in by the image renderer; stays empty in the other render modes
+  TerrainRasterStats RasterStats() const;
+  void RecordRasterStats(const TerrainRasterStats&);
+  // Starts a new frame of the page clock; call once per update before touching tiles
+  void BeginFrame();
+  const TileRange& VisibleRange() const;
+  void SetVisibleRange(const TileRange&);
+  void ForEachVisibleTile(const TileVisitor&);
+  // Use these instead of mutating tiles after construction, they keep the overlay
+  // draw order and every dirty consumer up to date
+  void SetTileTerrain(int x, int y, const WorldTileTerrainType&);
+  // Records come from TilesManager; nullptr removes the decoration or resource
+  void SetTileDecoration(int x, int y, const WorldTileDecoration*, uint32_t state = 0);
+  void SetTileResource(int x, int y, const WorldTileResource*, uint32_t volume = 0);
+  void SetTileResourceVolume(int x, int y, uint32_t volume);
+  void MarkTileDirty(int x, int y);
+  // Each consumer (renderer, minimap, saver) drains its own set at its own pace.
+  // A new consumer starts with the whole map dirty.
+  DirtyConsumer RegisterDirtyConsumer(int chunkSize);
+  TileDirtySet& DirtyTiles(DirtyConsumer);
+  // Systems run once per update over the tiles they want, whether visible or not
+  void RegisterSystem(std::unique_ptr<TileSystem>);
+  void UpdateSystems();
+  const TileSystemRegistry& Systems() const;
+  // Visible tiles with a decoration or resource in isometric painter's order (x + y, then x)
+  void ForEachVisibleOverlayTile(const TileVisitor&);
+  // Grid overlay is drawn as lines over the terrain, so these never force a re-raster
+  bool GridVisible() const;
+  void ToggleGrid();
+  Color2D GridColor() const;
+  void SetGridColor(Color2D);
   ~GameWorld();
 
 private:
   std::unique_ptr<GameCamera> camera;
-  std::vector<std::unique_ptr<WorldTile>> grid;
+  // Declared before everything allocated from it, so it is destroyed last
+  WorldArena arena;
+  WorldTileStorage tiles;
+  double buildMs;
+  TerrainRasterStats rasterStats;
+  TileRange visibleRange;
+  // Every overlay tile in draw order; unpaged worlds only, a paged one scans the view instead
+  std::vector<int> overlayOrder;
+  std::vector<std::unique_ptr<TileDirtySet>> dirtyConsumers;
+  TileSystemRegistry systems;
+  bool gridVisible;
+  Color2D gridColor;
   void InitializeGrid(TileProvider);
+  void forEachVisibleOverlayTileScan(const TileVisitor&);
+  bool overlayBefore(int index1, int index2) const;
+  void updateOverlayOrder(int index);
+  void checkBounds(int x, int y) const;
+  void tileChanged(int x, int y);
 };
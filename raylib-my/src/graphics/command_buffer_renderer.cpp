@@ -0,0 +1,374 @@
+#include "command_buffer_renderer.h"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <tuple>
+
+namespace {
+  // Text and FPS counter are drawn with the font texture, which has no handle of its own
+  constexpr uint32_t kFontResource = std::numeric_limits<uint32_t>::max();
+}
+
+CommandBufferRenderer::CommandBufferRenderer(RenderSystem& tgt):
+  target { tgt },
+  currentLayer { RenderLayer::Terrain },
+  commands { },
+  textArena { },
+  pendingTextureUnloads { },
+  pendingMeshUnloads { },
+  frameStats { },
+  lastFrameStats { }
+{}
+
+CommandBufferRenderer::~CommandBufferRenderer() = default;
+
+const RenderCommandStats& CommandBufferRenderer::LastFrameStats() const {
+  return lastFrameStats;
+}
+
+CommandBufferRenderer::Command& CommandBufferRenderer::record(CommandKind kind, uint32_t resource) {
+  Command command {};
+  command.kind = kind;
+  command.layer = currentLayer;
+  command.resource = resource;
+  command.sequence = static_cast<uint32_t>(commands.size());
+  commands.push_back(command);
+  ++frameStats.commandsRecorded;
+  return commands.back();
+}
+
+bool CommandBufferRenderer::isBarrier(CommandKind kind) {
+  return kind == CommandKind::Clear || kind == CommandKind::BeginMode2D || kind == CommandKind::EndMode2D ||
+         kind == CommandKind::BeginTextureMode || kind == CommandKind::EndTextureMode;
+}
+
+void CommandBufferRenderer::BeginDrawing() {
+  commands.clear();
+  textArena.clear();
+  frameStats = {};
+  currentLayer = RenderLayer::Terrain;
+  target.BeginDrawing();
+}
+
+void CommandBufferRenderer::EndDrawing() {
+  flush();
+  target.EndDrawing();
+  lastFrameStats = frameStats;
+}
+
+void CommandBufferRenderer::flush() {
+  size_t segmentBegin = 0;
+  for (size_t i = 0; i < commands.size(); ++i) {
+    if (!isBarrier(commands[i].kind)) continue;
+
+    replaySorted(segmentBegin, i);
+    replay(commands[i]);
+    ++frameStats.batchesEmitted;
+    segmentBegin = i + 1;
+  }
+  replaySorted(segmentBegin, commands.size());
+
+  // Resources released mid-frame may still be referenced by recorded commands
+  for (TextureHandle texture : pendingTextureUnloads) {
+    target.UnloadTexture(texture);
+  }
+  for (MeshHandle mesh : pendingMeshUnloads) {
+    target.UnloadMesh(mesh);
+  }
+  pendingTextureUnloads.clear();
+  pendingMeshUnloads.clear();
+}
+
+void CommandBufferRenderer::replaySorted(size_t begin, size_t end) {
+  if (begin >= end) return;
+
+  std::sort(commands.begin() + begin, commands.begin() + end, [](const Command& a, const Command& b) {
+    return std::tie(a.layer, a.resource, a.kind, a.sequence) < std::tie(b.layer, b.resource, b.kind, b.sequence);
+  });
+
+  const Command* previous = nullptr;
+  for (size_t i = begin; i < end; ++i) {
+    const Command& command = commands[i];
+    if (!previous || previous->resource != command.resource || previous->kind != command.kind) {
+      ++frameStats.batchesEmitted;
+    }
+    replay(command);
+    previous = &command;
+  }
+}
+
+void CommandBufferRenderer::replay(const Command& command) {
+  switch (command.kind) {
+    case CommandKind::Clear:
+      target.ClearBackground(command.color);
+      break;
+    case CommandKind::BeginMode2D:
+      target.BeginMode2D();
+      break;
+    case CommandKind::EndMode2D:
+      target.EndMode2D();
+      break;
+    case CommandKind::BeginTextureMode:
+      target.BeginTextureMode(TextureHandle(command.resource));
+      break;
+    case CommandKind::EndTextureMode:
+      target.EndTextureMode();
+      break;
+    case CommandKind::Rectangle:
+      target.DrawRectangle({ command.x, command.y, command.width, command.height }, command.color);
+      break;
+    case CommandKind::DiamondFrame:
+      target.DrawDiamondFrame({ command.x, command.y }, command.color, false, command.scalar);
+      break;
+    case CommandKind::Line:
+      target.DrawLine({ command.x, command.y }, { command.width, command.height }, command.color, command.scalar);
+      break;
+    case CommandKind::Texture:
+      target.DrawTexture(TextureHandle(command.resource), { command.x, command.y }, command.color, command.scalar);
+      break;
+    case CommandKind::TexturePro:
+      target.DrawTexturePro(
+        TextureHandle(command.resource),
+        { command.srcX, command.srcY, command.srcWidth, command.srcHeight },
+        { command.x, command.y, command.width, command.height },
+        command.color
+      );
+      break;
+    case CommandKind::Text:
+      target.DrawText(&textArena[command.textOffset], { command.x, command.y }, static_cast<int>(command.scalar), command.color);
+      break;
+    case CommandKind::Fps:
+      target.DrawFPS(static_cast<int>(command.x), static_cast<int>(command.y));
+      break;
+    case CommandKind::Mesh:
+      target.DrawMesh(MeshHandle(command.mesh), TextureHandle(command.resource));
+      break;
+  }
+}
+
+void CommandBufferRenderer::BeginMode2D() {
+  record(CommandKind::BeginMode2D, 0);
+}
+
+void CommandBufferRenderer::EndMode2D() {
+  record(CommandKind::EndMode2D, 0);
+}
+
+void CommandBufferRenderer::BeginTextureMode(TextureHandle texture) {
+  record(CommandKind::BeginTextureMode, texture.GetId());
+}
+
+void CommandBufferRenderer::EndTextureMode() {
+  record(CommandKind::EndTextureMode, 0);
+}
+
+void CommandBufferRenderer::ClearBackground(Color2D color) {
+  record(CommandKind::Clear, 0).color = color;
+}
+
+void CommandBufferRenderer::DrawRectangle(Rectangle2D rect, Color2D color) {
+  Command& command = record(CommandKind::Rectangle, 0);
+  command.x = rect.x;
+  command.y = rect.y;
+  command.width = rect.width;
+  command.height = rect.height;
+  command.color = color;
+}
+
+void CommandBufferRenderer::DrawDiamondFrame(Position2D center, Color2D color, bool dst, float thickness) {
+  // Frames rasterized into a CPU image are not draw calls
+  if (dst) {
+    target.DrawDiamondFrame(center, color, dst, thickness);
+    return;
+  }
+
+  Command& command = record(CommandKind::DiamondFrame, 0);
+  command.x = center.x;
+  command.y = center.y;
+  command.color = color;
+  command.scalar = thickness;
+}
+
+void CommandBufferRenderer::DrawLine(Position2D start, Position2D end, Color2D color, float thickness) {
+  // End point goes in the width/height slots
+  Command& command = record(CommandKind::Line, 0);
+  command.x = start.x;
+  command.y = start.y;
+  command.width = end.x;
+  command.height = end.y;
+  command.color = color;
+  command.scalar = thickness;
+}
+
+void CommandBufferRenderer::DrawTexture(TextureHandle texture, Position2D position, Color2D tint, float scale) {
+  if (!texture.IsValid()) return;
+  Command& command = record(CommandKind::Texture, texture.GetId());
+  command.x = position.x;
+  command.y = position.y;
+  command.color = tint;
+  command.scalar = scale;
+}
+
+void CommandBufferRenderer::DrawTexturePro(TextureHandle texture, Rectangle2D srcRect, Rectangle2D dstRect, Color2D tint) {
+  if (!texture.IsValid()) return;
+  Command& command = record(CommandKind::TexturePro, texture.GetId());
+  command.x = dstRect.x;
+  command.y = dstRect.y;
+  command.width = dstRect.width;
+  command.height = dstRect.height;
+  command.srcX = srcRect.x;
+  command.srcY = srcRect.y;
+  command.srcWidth = srcRect.width;
+  command.srcHeight = srcRect.height;
+  command.color = tint;
+}
+
+void CommandBufferRenderer::DrawText(const char* text, Position2D position, int fontSize, Color2D color) {
+  size_t length = std::strlen(text);
+  uint32_t offset = static_cast<uint32_t>(textArena.size());
+  textArena.insert(textArena.end(), text, text + length + 1);
+
+  Command& command = record(CommandKind::Text, kFontResource);
+  command.x = position.x;
+  command.y = position.y;
+  command.scalar = static_cast<float>(fontSize);
+  command.color = color;
+  command.textOffset = offset;
+}
+
+void CommandBufferRenderer::DrawFPS(int x, int y) {
+  Command& command = record(CommandKind::Fps, kFontResource);
+  command.x = static_cast<float>(x);
+  command.y = static_cast<float>(y);
+}
+
+void CommandBufferRenderer::DrawMesh(MeshHandle mesh, TextureHandle texture) {
+  if (!mesh.IsValid() || !texture.IsValid()) return;
+  record(CommandKind::Mesh, texture.GetId()).mesh = mesh.GetId();
+}
+
+void CommandBufferRenderer::SetLayer(RenderLayer::Layer layer) {
+  currentLayer = layer;
+}
+
+void CommandBufferRenderer::UnloadTexture(TextureHandle texture) {
+  pendingTextureUnloads.push_back(texture);
+}
+
+void CommandBufferRenderer::UnloadMesh(MeshHandle mesh) {
+  pendingMeshUnloads.push_back(mesh);
+}
+
+void CommandBufferRenderer::UpdateGrphCamera(const GrphCamera& camera) {
+  target.UpdateGrphCamera(camera);
+}
+
+const GrphCamera& CommandBufferRenderer::GetGrphCamera() const {
+  return target.GetGrphCamera();
+}
+
+Position2D CommandBufferRenderer::GridToScreen(Position2D pos) {
+  return target.GridToScreen(pos);
+}
+
+Position2D CommandBufferRenderer::ScreenToWorld2D(Position2D screenPos) {
+  return target.ScreenToWorld2D(screenPos);
+}
+
+Position2D CommandBufferRenderer::ScreenToWorldWithCamera(const GrphCamera& camera) {
+  return target.ScreenToWorldWithCamera(camera);
+}
+
+Position2D CommandBufferRenderer::MouseToWorld2D() {
+  return target.MouseToWorld2D();
+}
+
+TileRange CommandBufferRenderer::VisibleTileRange(int mapWidth, int mapHeight) const {
+  return target.VisibleTileRange(mapWidth, mapHeight);
+}
+
+float CommandBufferRenderer::GetTileWidth() const {
+  return target.GetTileWidth();
+}
+
+float CommandBufferRenderer::GetTileHeight() const {
+  return target.GetTileHeight();
+}
+
+Position2D CommandBufferRenderer::GetCorrection() const {
+  return target.GetCorrection();
+}
+
+ImageHandle CommandBufferRenderer::GetDst() const {
+  return target.GetDst();
+}
+
+void CommandBufferRenderer::ImageDraw(ImageHandle dst, ImageHandle src, Rectangle2D srcRect, Rectangle2D dstRect, Color2D tint) {
+  target.ImageDraw(dst, src, srcRect, dstRect, tint);
+}
+
+void CommandBufferRenderer::ImageBlit(ImageHandle dst, ImageHandle src, Position2D position) {
+  target.ImageBlit(dst, src, position);
+}
+
+void CommandBufferRenderer::ImageDrawLineEx(ImageHandle dst, Position2D start, Position2D end, float thickness, Color2D color) {
+  target.ImageDrawLineEx(dst, start, end, thickness, color);
+}
+
+void CommandBufferRenderer::ImageDrawPixel(ImageHandle dst, int x, int y, Color2D color) {
+  target.ImageDrawPixel(dst, x, y, color);
+}
+
+void CommandBufferRenderer::ImageDownsample(ImageHandle src, ImageHandle dst, Rectangle2D dstRegion) {
+  target.ImageDownsample(src, dst, dstRegion);
+}
+
+int CommandBufferRenderer::GetImageWidth(ImageHandle image) const {
+  return target.GetImageWidth(image);
+}
+
+int CommandBufferRenderer::GetImageHeight(ImageHandle image) const {
+  return target.GetImageHeight(image);
+}
+
+int CommandBufferRenderer::GetTextureWidth(TextureHandle texture) const {
+  return target.GetTextureWidth(texture);
+}
+
+int CommandBufferRenderer::GetTextureHeight(TextureHandle texture) const {
+  return target.GetTextureHeight(texture);
+}
+
+void CommandBufferRenderer::SetDst(ImageHandle dst) {
+  target.SetDst(dst);
+}
+
+void CommandBufferRenderer::SetCorrection(Position2D correction) {
+  target.SetCorrection(correction);
+}
+
+ImageHandle CommandBufferRenderer::GenImageColor(float width, float height, Color2D color) {
+  return target.GenImageColor(width, height, color);
+}
+
+TextureHandle CommandBufferRenderer::LoadTextureFromImage(ImageHandle image) {
+  return target.LoadTextureFromImage(image);
+}
+
+void CommandBufferRenderer::UnloadImage(ImageHandle image) {
+  target.UnloadImage(image);
+}
+
+void CommandBufferRenderer::UpdateTextureRegion(TextureHandle texture, ImageHandle image, Rectangle2D region) {
+  target.UpdateTextureRegion(texture, image, region);
+}
+
+TextureHandle CommandBufferRenderer::LoadRenderTexture(int width, int height) {
+  return target.LoadRenderTexture(width, height);
+}
+
+MeshHandle CommandBufferRenderer::LoadMesh(const std::vector<Position2D>& vertices, const std::vector<Position2D>& texcoords,
+                                           const std::vector<uint16_t>& indices) {
+  return target.LoadMesh(vertices, texcoords, indices);
+}
@@ -0,0 +1,117 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "render_system.h"
+
+struct RenderCommandStats {
+  size_t commandsRecorded = 0;
+  size_t batchesEmitted = 0;
+};
+
+// Records draw calls for the whole frame and replays them on EndDrawing, sorted by layer
+// and texture so the target sees long runs of same-state draws. Clear, 2D mode and texture
+// mode changes act as barriers: commands never move across them. Non-draw calls are forwarded as-is.
+class CommandBufferRenderer : public RenderSystem {
+public:
+  explicit CommandBufferRenderer(RenderSystem& target);
+  ~CommandBufferRenderer() override;
+
+  CommandBufferRenderer(const CommandBufferRenderer&) = delete;
+  CommandBufferRenderer& operator=(const CommandBufferRenderer&) = delete;
+
+  const RenderCommandStats& LastFrameStats() const;
+
+  void BeginDrawing() override;
+  void EndDrawing() override;
+  void BeginMode2D() override;
+  void EndMode2D() override;
+  void DrawRectangle(Rectangle2D rect, Color2D color) override;
+  void DrawDiamondFrame(Position2D center, Color2D color, bool dst, float thickness) override;
+  void DrawLine(Position2D start, Position2D end, Color2D color, float thickness) override;
+
+  void UpdateGrphCamera(const GrphCamera& camera) override;
+  const GrphCamera& GetGrphCamera() const override;
+
+  Position2D GridToScreen(Position2D pos) override;
+  Position2D ScreenToWorld2D(Position2D screenPos) override;
+  Position2D ScreenToWorldWithCamera(const GrphCamera& camera) override;
+  Position2D MouseToWorld2D() override;
+  TileRange VisibleTileRange(int mapWidth, int mapHeight) const override;
+
+  float GetTileWidth() const override;
+  float GetTileHeight() const override;
+  Position2D GetCorrection() const override;
+  ImageHandle GetDst() const override;
+
+  void ImageDraw(ImageHandle dst, ImageHandle src, Rectangle2D srcRect, Rectangle2D dstRect, Color2D tint) override;
+  void ImageBlit(ImageHandle dst, ImageHandle src, Position2D position) override;
+  void ImageDrawLineEx(ImageHandle dst, Position2D start, Position2D end, float thickness, Color2D color) override;
+  void ImageDrawPixel(ImageHandle dst, int x, int y, Color2D color) override;
+  void ImageDownsample(ImageHandle src, ImageHandle dst, Rectangle2D dstRegion) override;
+  int GetImageWidth(ImageHandle image) const override;
+  int GetImageHeight(ImageHandle image) const override;
+  int GetTextureWidth(TextureHandle texture) const override;
+  int GetTextureHeight(TextureHandle texture) const override;
+
+  void ClearBackground(Color2D color) override;
+  void DrawTexture(TextureHandle texture, Position2D position, Color2D tint, float scale = 1.0f) override;
+  void DrawTexturePro(TextureHandle texture, Rectangle2D srcRect, Rectangle2D dstRect, Color2D tint) override;
+  void DrawText(const char* text, Position2D position, int fontSize, Color2D color) override;
+  void DrawFPS(int x, int y) override;
+  void SetLayer(RenderLayer::Layer layer) override;
+
+  void SetDst(ImageHandle dst) override;
+  void SetCorrection(Position2D correction) override;
+
+  ImageHandle GenImageColor(float width, float height, Color2D color) override;
+  TextureHandle LoadTextureFromImage(ImageHandle image) override;
+  void UnloadTexture(TextureHandle texture) override;
+  void UnloadImage(ImageHandle image) override;
+  void UpdateTextureRegion(TextureHandle texture, ImageHandle image, Rectangle2D region) override;
+  TextureHandle LoadRenderTexture(int width, int height) override;
+  void BeginTextureMode(TextureHandle target) override;
+  void EndTextureMode() override;
+
+  MeshHandle LoadMesh(const std::vector<Position2D>& vertices, const std::vector<Position2D>& texcoords,
+                      const std::vector<uint16_t>& indices) override;
+  void DrawMesh(MeshHandle mesh, TextureHandle texture) override;
+  void UnloadMesh(MeshHandle mesh) override;
+
+private:
+  enum class CommandKind : uint8_t {
+    Clear, BeginMode2D, EndMode2D, BeginTextureMode, EndTextureMode,
+    Rectangle, DiamondFrame, Line, Texture, TexturePro, Text, Fps, Mesh
+  };
+
+  // Flat POD record; text lives in textArena and is referenced by offset
+  struct Command {
+    CommandKind kind;
+    RenderLayer::Layer layer;
+    uint32_t resource;
+    uint32_t sequence;
+    float x, y, width, height;
+    float srcX, srcY, srcWidth, srcHeight;
+    float scalar;
+    Color2D color;
+    uint32_t textOffset;
+    uint32_t mesh;
+  };
+
+  Command& record(CommandKind kind, uint32_t resource);
+  void flush();
+  void replaySorted(size_t begin, size_t end);
+  void replay(const Command&);
+  static bool isBarrier(CommandKind kind);
+
+  RenderSystem& target;
+  RenderLayer::Layer currentLayer;
+  std::vector<Command> commands;
+  std::vector<char> textArena;
+  std::vector<TextureHandle> pendingTextureUnloads;
+  std::vector<MeshHandle> pendingMeshUnloads;
+  RenderCommandStats frameStats;
+  RenderCommandStats lastFrameStats;
+};
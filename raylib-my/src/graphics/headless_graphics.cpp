@@ -0,0 +1,531 @@
+#include "headless_graphics.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#include "raylib.h"
+#include "raylib_helpers.h"
+#include "slot_map.h"
+#include "../common/game_error.h"
+
+namespace {
+
+struct HeadlessMesh {
+  std::vector<Position2D> vertices;
+  std::vector<Position2D> texcoords;
+  std::vector<uint16_t> indices;
+};
+
+constexpr int kMouseLeftButton = 0;
+
+void BlendPixel(unsigned char* dst, Color color) {
+  unsigned int a = color.a;
+  unsigned int inv = 255 - a;
+  dst[0] = static_cast<unsigned char>((color.r * a + dst[0] * inv) / 255);
+  dst[1] = static_cast<unsigned char>((color.g * a + dst[1] * inv) / 255);
+  dst[2] = static_cast<unsigned char>((color.b * a + dst[2] * inv) / 255);
+  dst[3] = static_cast<unsigned char>(a + dst[3] * inv / 255);
+}
+
+Color SampleTinted(const Image& src, int x, int y, Color tint) {
+  x = std::clamp(x, 0, src.width - 1);
+  y = std::clamp(y, 0, src.height - 1);
+  const unsigned char* p = static_cast<const unsigned char*>(src.data) + 4 * (y * src.width + x);
+  return Color {
+    static_cast<unsigned char>(p[0] * tint.r / 255),
+    static_cast<unsigned char>(p[1] * tint.g / 255),
+    static_cast<unsigned char>(p[2] * tint.b / 255),
+    static_cast<unsigned char>(p[3] * tint.a / 255)
+  };
+}
+
+void FillRect(Image& fb, Rectangle rect, Color color) {
+  Rectangle clip = ClampToImage({ rect.x, rect.y, rect.width, rect.height }, fb);
+  unsigned char* pixels = static_cast<unsigned char*>(fb.data);
+  for (int y = int(clip.y); y < int(clip.y + clip.height); ++y) {
+    for (int x = int(clip.x); x < int(clip.x + clip.width); ++x) {
+      BlendPixel(pixels + 4 * (y * fb.width + x), color);
+    }
+  }
+}
+
+// Nearest-neighbour scaled blit; a GPU sampler with point filtering does the same
+void BlitScaled(Image& fb, const Image& src, Rectangle srcRect, Rectangle dstRect, Color tint) {
+  if (dstRect.width <= 0.0f || dstRect.height <= 0.0f || src.width <= 0 || src.height <= 0) return;
+  Rectangle clip = ClampToImage({ dstRect.x, dstRect.y, dstRect.width, dstRect.height }, fb);
+  float stepX = srcRect.width / dstRect.width;
+  float stepY = srcRect.height / dstRect.height;
+  unsigned char* pixels = static_cast<unsigned char*>(fb.data);
+
+  for (int y = int(clip.y); y < int(clip.y + clip.height); ++y) {
+    int sy = int(std::floor(srcRect.y + (y + 0.5f - dstRect.y) * stepY));
+    for (int x = int(clip.x); x < int(clip.x + clip.width); ++x) {
+      int sx = int(std::floor(srcRect.x + (x + 0.5f - dstRect.x) * stepX));
+      Color texel = SampleTinted(src, sx, sy, tint);
+      if (texel.a == 0) continue;
+      BlendPixel(pixels + 4 * (y * fb.width + x), texel);
+    }
+  }
+}
+
+float EdgeFunction(Position2D a, Position2D b, float px, float py) {
+  return (b.x - a.x) * (py - a.y) - (b.y - a.y) * (px - a.x);
+}
+
+void RasterTriangle(Image& fb, const Position2D* p, const Position2D* uv, const Image& tex) {
+  float area = EdgeFunction(p[0], p[1], p[2].x, p[2].y);
+  if (area == 0.0f) return;
+
+  float minX = std::min({ p[0].x, p[1].x, p[2].x });
+  float minY = std::min({ p[0].y, p[1].y, p[2].y });
+  float maxX = std::max({ p[0].x, p[1].x, p[2].x });
+  float maxY = std::max({ p[0].y, p[1].y, p[2].y });
+  Rectangle clip = ClampToImage({ minX, minY, maxX - minX, maxY - minY }, fb);
+  unsigned char* pixels = static_cast<unsigned char*>(fb.data);
+  const Color white { 255, 255, 255, 255 };
+
+  for (int y = int(clip.y); y < int(clip.y + clip.height); ++y) {
+    for (int x = int(clip.x); x < int(clip.x + clip.width); ++x) {
+      float px = x + 0.5f;
+      float py = y + 0.5f;
+      // Dividing by the signed area makes the test independent of winding
+      float w0 = EdgeFunction(p[1], p[2], px, py) / area;
+      float w1 = EdgeFunction(p[2], p[0], px, py) / area;
+      float w2 = EdgeFunction(p[0], p[1], px, py) / area;
+      if (w0 < 0.0f || w1 < 0.0f || w2 < 0.0f) continue;
+
+      float u = w0 * uv[0].x + w1 * uv[1].x + w2 * uv[2].x;
+      float v = w0 * uv[0].y + w1 * uv[1].y + w2 * uv[2].y;
+      Color texel = SampleTinted(tex, int(u * tex.width), int(v * tex.height), white);
+      if (texel.a == 0) continue;
+      BlendPixel(pixels + 4 * (y * fb.width + x), texel);
+    }
+  }
+}
+
+}
+
+struct HeadlessGraphics::Impl {
+  // Textures are CPU images too, always stored as RGBA8 so the rasterizer has one format
+  SlotMap<Image> textures;
+  SlotMap<Image> images;
+  SlotMap<HeadlessMesh> meshes;
+  Image framebuffer;
+  // Render texture between Begin/EndTextureMode; kept as a handle since slots move on insert
+  TextureHandle renderTarget;
+
+  Image& Target() {
+    return renderTarget.IsValid() ? textures.At(renderTarget.GetId()) : framebuffer;
+  }
+};
+
+HeadlessGraphics::HeadlessGraphics(int s_w, int s_h, float t_w, float t_h):
+  ScreenWidth { s_w },
+  ScreenHeight { s_h },
+  TileWidth { t_w },
+  TileHeight { t_h },
+  Correction { Position2D { 0.0f, 0.0f } },
+  camera { { ScreenWidth / 2.0f, ScreenHeight / 4.0f }, { 0.0f, 0.0f }, 0.0f, 1.0f },
+  projection { t_w, t_h },
+  inMode2D { false },
+  frameIndex { 0 },
+  impl { std::make_unique<Impl>() }
+{
+  impl->framebuffer = ::GenImageColor(ScreenWidth, ScreenHeight, Color { 0, 0, 0, 255 });
+}
+
+HeadlessGraphics::~HeadlessGraphics() {
+  impl->textures.ForEach([](Image& img) { ::UnloadImage(img); });
+  impl->images.ForEach([](Image& img) { ::UnloadImage(img); });
+  ::UnloadImage(impl->framebuffer);
+}
+
+void HeadlessGraphics::SetInputScript(std::vector<HeadlessInputFrame> script) {
+  inputScript = std::move(script);
+  frameIndex = 0;
+}
+
+int HeadlessGraphics::FrameIndex() const {
+  return frameIndex;
+}
+
+const HeadlessRenderStats& HeadlessGraphics::LastFrameStats() const {
+  return lastFrameStats;
+}
+
+bool HeadlessGraphics::ExportFrame(const char* filename) const {
+  return ::ExportImage(impl->framebuffer, filename);
+}
+
+const HeadlessInputFrame& HeadlessGraphics::currentInput() const {
+  static const HeadlessInputFrame idle;
+  if (frameIndex < int(inputScript.size())) return inputScript[frameIndex];
+  return idle;
+}
+
+Position2D HeadlessGraphics::toScreen(Position2D pos) const {
+  if (!inMode2D) return pos;
+
+  float dx = (pos.x - camera.target.x) * camera.zoom;
+  float dy = (pos.y - camera.target.y) * camera.zoom;
+  float radians = camera.rotation * 3.14159265f / 180.0f;
+  float c = std::cos(radians);
+  float s = std::sin(radians);
+  return { camera.offset.x + dx * c - dy * s, camera.offset.y + dx * s + dy * c };
+}
+
+// InputSystem implementation
+Position2D HeadlessGraphics::GetMousePosition() const {
+  return currentInput().mouse;
+}
+
+bool HeadlessGraphics::IsKeyPressed(Keyboard2D::Key key) const {
+  const std::vector<Keyboard2D::Key>& keys = currentInput().keysPressed;
+  return std::find(keys.begin(), keys.end(), key) != keys.end();
+}
+
+bool HeadlessGraphics::IsMouseButtonPressed(int button) const {
+  return button == kMouseLeftButton && currentInput().leftClick;
+}
+
+bool HeadlessGraphics::IsKeyDown(Keyboard2D::Key key) const {
+  const std::vector<Keyboard2D::Key>& keys = currentInput().keysDown;
+  return std::find(keys.begin(), keys.end(), key) != keys.end();
+}
+
+float HeadlessGraphics::GetMouseWheelMove() const {
+  return currentInput().wheel;
+}
+
+// CollisionSystem implementation
+bool HeadlessGraphics::CheckCollisionPointRec(Position2D point, Rectangle2D rect) const {
+  return ::CheckCollisionPointRec(ToRaylibVector2(point), ToRaylibRectangle(rect));
+}
+
+bool HeadlessGraphics::CheckCollisionRecs(Rectangle2D rec1, Rectangle2D rec2) const {
+  return ::CheckCollisionRecs(ToRaylibRectangle(rec1), ToRaylibRectangle(rec2));
+}
+
+// RenderSystem implementation
+void HeadlessGraphics::BeginDrawing() {
+  frameStats = HeadlessRenderStats {};
+}
+
+void HeadlessGraphics::EndDrawing() {
+  lastFrameStats = frameStats;
+  ++frameIndex;
+}
+
+void HeadlessGraphics::BeginMode2D() {
+  inMode2D = true;
+}
+
+void HeadlessGraphics::EndMode2D() {
+  inMode2D = false;
+}
+
+void HeadlessGraphics::UpdateGrphCamera(const GrphCamera& grphCamera) {
+  camera = grphCamera;
+}
+
+const GrphCamera& HeadlessGraphics::GetGrphCamera() const {
+  return camera;
+}
+
+Position2D HeadlessGraphics::GridToScreen(Position2D pos) {
+  return projection.GridToWorld(pos);
+}
+
+Position2D HeadlessGraphics::ScreenToWorld2D(Position2D world) {
+  return projection.WorldToTile(world);
+}
+
+Position2D HeadlessGraphics::ScreenToWorldWithCamera(const GrphCamera& grphCamera) {
+  return grphCamera.ScreenToWorld(GetMousePosition());
+}
+
+Position2D HeadlessGraphics::MouseToWorld2D() {
+  return projection.WorldToTile(camera.ScreenToWorld(GetMousePosition()));
+}
+
+TileRange HeadlessGraphics::VisibleTileRange(int mapWidth, int mapHeight) const {
+  return projection.VisibleTileRange(camera, ScreenWidth, ScreenHeight, mapWidth, mapHeight);
+}
+
+float HeadlessGraphics::GetTileWidth() const {
+  return TileWidth;
+}
+
+float HeadlessGraphics::GetTileHeight() const {
+  return TileHeight;
+}
+
+Position2D HeadlessGraphics::GetCorrection() const {
+  return Correction;
+}
+
+ImageHandle HeadlessGraphics::GetDst() const {
+  return Dst;
+}
+
+void HeadlessGraphics::SetDst(ImageHandle dst) {
+  Dst = dst;
+}
+
+void HeadlessGraphics::SetCorrection(Position2D correction) {
+  Correction = correction;
+}
+
+void HeadlessGraphics::SetLayer(RenderLayer::Layer) {
+  // Immediate mode: submission order already is the draw order
+}
+
+void HeadlessGraphics::ClearBackground(Color2D color) {
+  ::ImageClearBackground(&impl->Target(), ToRaylibColor(color));
+}
+
+// The game camera never rotates, so rectangles only get translated and zoomed
+void HeadlessGraphics::DrawRectangle(Rectangle2D rect, Color2D color) {
+  Position2D origin = toScreen({ rect.x, rect.y });
+  float zoom = inMode2D ? camera.zoom : 1.0f;
+  FillRect(impl->Target(), Rectangle { origin.x, origin.y, rect.width * zoom, rect.height * zoom }, ToRaylibColor(color));
+  ++frameStats.rectangleDraws;
+}
+
+void HeadlessGraphics::DrawTexture(TextureHandle textureHandle, Position2D position, Color2D tint, float scale) {
+  if (!textureHandle.IsValid()) return;
+  const Image& tex = impl->textures.At(textureHandle.GetId());
+  DrawTexturePro(textureHandle, { 0.0f, 0.0f, float(tex.width), float(tex.height) },
+                 { position.x, position.y, tex.width * scale, tex.height * scale }, tint);
+}
+
+void HeadlessGraphics::DrawTexturePro(TextureHandle textureHandle, Rectangle2D srcRect, Rectangle2D dstRect, Color2D tint) {
+  if (!textureHandle.IsValid()) return;
+  const Image& tex = impl->textures.At(textureHandle.GetId());
+  Position2D origin = toScreen({ dstRect.x, dstRect.y });
+  float zoom = inMode2D ? camera.zoom : 1.0f;
+  BlitScaled(impl->Target(), tex, ToRaylibRectangle(srcRect),
+             Rectangle { origin.x, origin.y, dstRect.width * zoom, dstRect.height * zoom }, ToRaylibColor(tint));
+  ++frameStats.textureDraws;
+}
+
+void HeadlessGraphics::DrawText(const char*, Position2D, int, Color2D) {
+  ++frameStats.textDraws;
+}
+
+void HeadlessGraphics::DrawFPS(int, int) {
+  ++frameStats.textDraws;
+}
+
+void HeadlessGraphics::DrawDiamondFrame(Position2D center, Color2D color, bool dst, float thickness) {
+  Position2D corners[] = {
+    { center.x, center.y - TileHeight * 0.5f },
+    { center.x + TileWidth * 0.5f, center.y },
+    { center.x, center.y + TileHeight * 0.5f },
+    { center.x - TileWidth * 0.5f, center.y }
+  };
+  Color raylibColor = ToRaylibColor(color);
+
+  if (dst && Dst.IsValid()) {
+    Image& dstImage = impl->images.At(Dst.GetId());
+    for (int i = 0; i < 4; ++i) {
+      ::ImageDrawLineEx(&dstImage, ToRaylibVector2(corners[i]), ToRaylibVector2(corners[(i + 1) % 4]),
+                        (int)thickness, raylibColor);
+    }
+  } else {
+    for (int i = 0; i < 4; ++i) {
+      ::ImageDrawLineEx(&impl->Target(), ToRaylibVector2(toScreen(corners[i])),
+                        ToRaylibVector2(toScreen(corners[(i + 1) % 4])), std::max(1, (int)thickness), raylibColor);
+    }
+    frameStats.lineDraws += 4;
+  }
+}
+
+void HeadlessGraphics::DrawLine(Position2D start, Position2D end, Color2D color, float thickness) {
+  ::ImageDrawLineEx(&impl->Target(), ToRaylibVector2(toScreen(start)), ToRaylibVector2(toScreen(end)),
+                    std::max(1, (int)thickness), ToRaylibColor(color));
+  ++frameStats.lineDraws;
+}
+
+TextureHandle HeadlessGraphics::LoadRenderTexture(int width, int height) {
+  return TextureHandle(impl->textures.Insert(::GenImageColor(width, height, Color { 0, 0, 0, 0 })));
+}
+
+// Like raylib, texture mode draws in the target's own pixel space without the camera
+void HeadlessGraphics::BeginTextureMode(TextureHandle targetHandle) {
+  impl->textures.At(targetHandle.GetId()); // rejects stale handles up front
+  impl->renderTarget = targetHandle;
+  inMode2D = false;
+}
+
+void HeadlessGraphics::EndTextureMode() {
+  impl->renderTarget = TextureHandle();
+}
+
+MeshHandle HeadlessGraphics::LoadMesh(const std::vector<Position2D>& vertices, const std::vector<Position2D>& texcoords,
+                                      const std::vector<uint16_t>& indices) {
+  if (vertices.empty() || vertices.size() != texcoords.size() || indices.size() % 3 != 0) {
+    throw GameError("Mesh requires matching vertex/texcoord counts and whole triangles");
+  }
+
+  return MeshHandle(impl->meshes.Insert(HeadlessMesh { vertices, texcoords, indices }));
+}
+
+void HeadlessGraphics::DrawMesh(MeshHandle meshHandle, TextureHandle textureHandle) {
+  if (!meshHandle.IsValid() || !textureHandle.IsValid()) return;
+  const HeadlessMesh& mesh = impl->meshes.At(meshHandle.GetId());
+  const Image& tex = impl->textures.At(textureHandle.GetId());
+
+  for (size_t i = 0; i + 2 < mesh.indices.size(); i += 3) {
+    const uint16_t* tri = &mesh.indices[i];
+    Position2D screen[3] = {
+      toScreen(mesh.vertices[tri[0]]), toScreen(mesh.vertices[tri[1]]), toScreen(mesh.vertices[tri[2]])
+    };
+    Position2D uv[3] = { mesh.texcoords[tri[0]], mesh.texcoords[tri[1]], mesh.texcoords[tri[2]] };
+    RasterTriangle(impl->Target(), screen, uv, tex);
+  }
+  frameStats.meshTriangles += int(mesh.indices.size() / 3);
+}
+
+void HeadlessGraphics::UnloadMesh(MeshHandle meshHandle) {
+  if (!meshHandle.IsValid()) return;
+  impl->meshes.Erase(meshHandle.GetId());
+}
+
+// ResourcesSystem implementation
+TextureHandle HeadlessGraphics::LoadTexture(const char* filename) {
+  Image img = ::LoadImage(filename);
+  ::ImageFormat(&img, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8);
+  return TextureHandle(impl->textures.Insert(img));
+}
+
+ImageHandle HeadlessGraphics::LoadImage(const char* filename) {
+  Image img = ::LoadImage(filename);
+  return ImageHandle(impl->images.Insert(img));
+}
+
+ImageHandle HeadlessGraphics::LoadImageFromTexture(TextureHandle textureHandle) {
+  Image img = ::ImageCopy(impl->textures.At(textureHandle.GetId()));
+  return ImageHandle(impl->images.Insert(img));
+}
+
+TextureHandle HeadlessGraphics::LoadTextureFromImage(ImageHandle imageHandle) {
+  Image tex = ::ImageCopy(impl->images.At(imageHandle.GetId()));
+  ::ImageFormat(&tex, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8);
+  return TextureHandle(impl->textures.Insert(tex));
+}
+
+void HeadlessGraphics::UnloadTexture(TextureHandle textureHandle) {
+  if (!textureHandle.IsValid()) return;
+  Image* tex = impl->textures.Find(textureHandle.GetId());
+  if (!tex) return;
+
+  ::UnloadImage(*tex);
+  impl->textures.Erase(textureHandle.GetId());
+}
+
+void HeadlessGraphics::UnloadImage(ImageHandle imageHandle) {
+  if (!imageHandle.IsValid()) return;
+  Image* img = impl->images.Find(imageHandle.GetId());
+  if (!img) return;
+
+  ::UnloadImage(*img);
+  impl->images.Erase(imageHandle.GetId());
+}
+
+void HeadlessGraphics::UpdateTextureRegion(TextureHandle textureHandle, ImageHandle imageHandle, Rectangle2D region) {
+  if (!textureHandle.IsValid() || !imageHandle.IsValid()) return;
+  Image& tex = impl->textures.At(textureHandle.GetId());
+  const Image& img = impl->images.At(imageHandle.GetId());
+  if (img.format != tex.format) {
+    throw GameError("Texture region update requires matching image and texture formats");
+  }
+
+  Rectangle clip = ClampToImage(region, img);
+  int width = std::min(int(clip.width), tex.width - int(clip.x));
+  if (width <= 0) return;
+  for (int y = int(clip.y); y < std::min(int(clip.y + clip.height), tex.height); ++y) {
+    std::memcpy(static_cast<unsigned char*>(tex.data) + 4 * (y * tex.width + int(clip.x)),
+                static_cast<const unsigned char*>(img.data) + 4 * (y * img.width + int(clip.x)),
+                4 * width);
+  }
+}
+
+void HeadlessGraphics::ImageCrop(ImageHandle& imageHandle, Rectangle2D rect) {
+  if (!imageHandle.IsValid()) return;
+  ::ImageCrop(&impl->images.At(imageHandle.GetId()), ToRaylibRectangle(rect));
+}
+
+ImageHandle HeadlessGraphics::ImageFromImage(ImageHandle imageHandle, Rectangle2D rect) {
+  const Image& img = impl->images.At(imageHandle.GetId());
+  Image region = ::ImageFromImage(img, ClampToImage(rect, img));
+  return ImageHandle(impl->images.Insert(region));
+}
+
+void HeadlessGraphics::ImageDraw(ImageHandle dstHandle, ImageHandle srcHandle, Rectangle2D srcRect, Rectangle2D dstRect, Color2D tint) {
+  if (!dstHandle.IsValid() || !srcHandle.IsValid()) return;
+  Image& dst = impl->images.At(dstHandle.GetId());
+  const Image& src = impl->images.At(srcHandle.GetId());
+  ::ImageDraw(&dst, src, ToRaylibRectangle(srcRect), ToRaylibRectangle(dstRect), ToRaylibColor(tint));
+}
+
+void HeadlessGraphics::ImageBlit(ImageHandle dstHandle, ImageHandle srcHandle, Position2D position) {
+  if (!dstHandle.IsValid() || !srcHandle.IsValid()) return;
+  BlitImage(impl->images.At(dstHandle.GetId()), impl->images.At(srcHandle.GetId()), position);
+}
+
+void HeadlessGraphics::ImageDownsample(ImageHandle srcHandle, ImageHandle dstHandle, Rectangle2D dstRegion) {
+  if (!srcHandle.IsValid() || !dstHandle.IsValid()) return;
+  DownsampleImage(impl->images.At(srcHandle.GetId()), impl->images.At(dstHandle.GetId()), dstRegion);
+}
+
+void HeadlessGraphics::ImageDrawLineEx(ImageHandle dstHandle, Position2D start, Position2D end, float thickness, Color2D color) {
+  if (!dstHandle.IsValid()) return;
+  ::ImageDrawLineEx(&impl->images.At(dstHandle.GetId()), ToRaylibVector2(start), ToRaylibVector2(end),
+                    (int)thickness, ToRaylibColor(color));
+}
+
+void HeadlessGraphics::ImageDrawPixel(ImageHandle dstHandle, int x, int y, Color2D color) {
+  if (!dstHandle.IsValid()) return;
+  ::ImageDrawPixel(&impl->images.At(dstHandle.GetId()), x, y, ToRaylibColor(color));
+}
+
+ImageHandle HeadlessGraphics::GenImageColor(float width, float height, Color2D color) {
+  Image img = ::GenImageColor((int)width, (int)height, ToRaylibColor(color));
+  return ImageHandle(impl->images.Insert(img));
+}
+
+// Textures are CPU images here but are reported as GPU memory, as the windowed backend would
+ResourceMemoryStats HeadlessGraphics::MemoryStats() const {
+  ResourceMemoryStats stats;
+  impl->images.ForEach([&stats](const Image& img) {
+    ++stats.images;
+    stats.imageBytes += ::GetPixelDataSize(img.width, img.height, img.format);
+  });
+  impl->textures.ForEach([&stats](const Image& tex) {
+    ++stats.textures;
+    stats.textureBytes += ::GetPixelDataSize(tex.width, tex.height, tex.format);
+  });
+  return stats;
+}
+
+int HeadlessGraphics::GetImageWidth(ImageHandle handle) const {
+  if (!handle.IsValid()) return 0;
+  return impl->images.At(handle.GetId()).width;
+}
+
+int HeadlessGraphics::GetImageHeight(ImageHandle handle) const {
+  if (!handle.IsValid()) return 0;
+  return impl->images.At(handle.GetId()).height;
+}
+
+int HeadlessGraphics::GetTextureWidth(TextureHandle handle) const {
+  if (!handle.IsValid()) return 0;
+  return impl->textures.At(handle.GetId()).width;
+}
+
+int HeadlessGraphics::GetTextureHeight(TextureHandle handle) const {
+  if (!handle.IsValid()) return 0;
+  return impl->textures.At(handle.GetId()).height;
+}
@@ -0,0 +1,142 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "collision_system.h"
+#include "input_system.h"
+#include "render_system.h"
+#include "resources_system.h"
+#include "../common/keyboard_2d.h"
+#include "../common/color_2d.h"
+#include "../common/grph_camera.h"
+#include "../common/image_handle.h"
+#include "../common/iso_projection.h"
+#include "../common/mesh_handle.h"
+#include "../common/position_2d.h"
+#include "../common/rectangle_2d.h"
+#include "../common/texture_handle.h"
+#include "../common/tile_range.h"
+
+// Input state for one frame of a scripted headless run
+struct HeadlessInputFrame {
+  Position2D mouse { 0.0f, 0.0f };
+  std::vector<Keyboard2D::Key> keysDown;
+  std::vector<Keyboard2D::Key> keysPressed;
+  bool leftClick = false;
+  float wheel = 0.0f;
+};
+
+struct HeadlessRenderStats {
+  int textureDraws = 0;
+  int rectangleDraws = 0;
+  int lineDraws = 0;
+  int meshTriangles = 0;
+  int textDraws = 0;
+};
+
+// Window-less backend: textures live in CPU images and every draw is rasterized
+// into a CPU framebuffer, so the full game loop runs without a GL context.
+// Text needs the GPU-side default font and is only counted.
+class HeadlessGraphics : public InputSystem,
+                         public CollisionSystem,
+                         public RenderSystem,
+                         public ResourcesSystem {
+public:
+  int ScreenWidth;
+  int ScreenHeight;
+  float TileWidth;
+  float TileHeight;
+  ImageHandle Dst;
+  Position2D Correction;
+
+  HeadlessGraphics(int, int, float, float);
+  ~HeadlessGraphics();
+
+  void SetInputScript(std::vector<HeadlessInputFrame> script);
+  int FrameIndex() const;
+  const HeadlessRenderStats& LastFrameStats() const;
+  bool ExportFrame(const char* filename) const;
+
+  // InputSystem interface implementation
+  Position2D GetMousePosition() const override;
+  bool IsKeyPressed(Keyboard2D::Key key) const override;
+  bool IsMouseButtonPressed(int button) const override;
+  bool IsKeyDown(Keyboard2D::Key key) const override;
+  float GetMouseWheelMove() const override;
+
+  // CollisionSystem interface implementation
+  bool CheckCollisionPointRec(Position2D point, Rectangle2D rect) const override;
+  bool CheckCollisionRecs(Rectangle2D rec1, Rectangle2D rec2) const override;
+
+  // RenderSystem interface implementation
+  void BeginDrawing() override;
+  void EndDrawing() override;
+  void BeginMode2D() override;
+  void EndMode2D() override;
+  void DrawRectangle(Rectangle2D rect, Color2D color) override;
+  void DrawDiamondFrame(Position2D center, Color2D color, bool dst, float thickness) override;
+  void DrawLine(Position2D start, Position2D end, Color2D color, float thickness) override;
+  void UpdateGrphCamera(const GrphCamera& camera) override;
+  const GrphCamera& GetGrphCamera() const override;
+  Position2D GridToScreen(Position2D pos) override;
+  Position2D ScreenToWorld2D(Position2D screenPos) override;
+  Position2D ScreenToWorldWithCamera(const GrphCamera& camera) override;
+  Position2D MouseToWorld2D() override;
+  TileRange VisibleTileRange(int mapWidth, int mapHeight) const override;
+  float GetTileWidth() const override;
+  float GetTileHeight() const override;
+  Position2D GetCorrection() const override;
+  ImageHandle GetDst() const override;
+  void ImageDraw(ImageHandle dst, ImageHandle src, Rectangle2D srcRect, Rectangle2D dstRect, Color2D tint) override;
+  void ImageBlit(ImageHandle dst, ImageHandle src, Position2D position) override;
+  void ImageDownsample(ImageHandle src, ImageHandle dst, Rectangle2D dstRegion) override;
+  int GetImageWidth(ImageHandle image) const override;
+  int GetImageHeight(ImageHandle image) const override;
+  int GetTextureWidth(TextureHandle texture) const override;
+  int GetTextureHeight(TextureHandle texture) const override;
+  void ClearBackground(Color2D color) override;
+  void DrawTexture(TextureHandle texture, Position2D position, Color2D tint, float scale = 1.0f) override;
+  void DrawTexturePro(TextureHandle texture, Rectangle2D srcRect, Rectangle2D dstRect, Color2D tint) override;
+  void DrawText(const char* text, Position2D position, int fontSize, Color2D color) override;
+  void DrawFPS(int x, int y) override;
+  void SetLayer(RenderLayer::Layer layer) override;
+  void SetDst(ImageHandle dst) override;
+  void SetCorrection(Position2D correction) override;
+  TextureHandle LoadRenderTexture(int width, int height) override;
+  void BeginTextureMode(TextureHandle target) override;
+  void EndTextureMode() override;
+  MeshHandle LoadMesh(const std::vector<Position2D>& vertices, const std::vector<Position2D>& texcoords,
+                      const std::vector<uint16_t>& indices) override;
+  void DrawMesh(MeshHandle mesh, TextureHandle texture) override;
+  void UnloadMesh(MeshHandle mesh) override;
+
+  // ResourcesSystem interface implementation
+  TextureHandle LoadTexture(const char* filename) override;
+  ImageHandle LoadImage(const char* filename) override;
+  ImageHandle LoadImageFromTexture(TextureHandle texture) override;
+  TextureHandle LoadTextureFromImage(ImageHandle image) override;
+  void UnloadTexture(TextureHandle texture) override;
+  void UnloadImage(ImageHandle image) override;
+  void UpdateTextureRegion(TextureHandle texture, ImageHandle image, Rectangle2D region) override;
+  void ImageCrop(ImageHandle& image, Rectangle2D rect) override;
+  ImageHandle ImageFromImage(ImageHandle image, Rectangle2D rect) override;
+  void ImageDrawLineEx(ImageHandle dst, Position2D start, Position2D end, float thickness, Color2D color) override;
+  void ImageDrawPixel(ImageHandle dst, int x, int y, Color2D color) override;
+  ImageHandle GenImageColor(float width, float height, Color2D color) override;
+  ResourceMemoryStats MemoryStats() const override;
+
+private:
+  GrphCamera camera;
+  IsoProjection projection;
+  bool inMode2D;
+  std::vector<HeadlessInputFrame> inputScript;
+  int frameIndex;
+  HeadlessRenderStats frameStats;
+  HeadlessRenderStats lastFrameStats;
+  struct Impl;
+  std::unique_ptr<Impl> impl;
+
+  const HeadlessInputFrame& currentInput() const;
+  Position2D toScreen(Position2D pos) const;
+};
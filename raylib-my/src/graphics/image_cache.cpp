@@ -0,0 +1,35 @@
+#include "image_cache.h"
+
+#include "resources_system.h"
+#include "../common/game_error.h"
+
+ImageCache::ImageCache(ResourcesSystem& res):
+  resources { res },
+  images { }
+{}
+
+ImageHandle ImageCache::Get(const std::string& path) {
+  auto it = images.find(path);
+  if (it != images.end()) {
+    return it->second;
+  }
+
+  ImageHandle image = resources.LoadImage(path.c_str());
+  if (resources.GetImageWidth(image) == 0 || resources.GetImageHeight(image) == 0) {
+    resources.UnloadImage(image);
+    throw GameError("Failed to load image " + path);
+  }
+  images.emplace(path, image);
+  return image;
+}
+
+void ImageCache::Clear() {
+  for (auto& [path, image] : images) {
+    resources.UnloadImage(image);
+  }
+  images.clear();
+}
+
+ImageCache::~ImageCache() {
+  Clear();
+}
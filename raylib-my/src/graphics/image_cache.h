@@ -0,0 +1,28 @@
+#pragma once
+
+#include <string>
+#include <unordered_map>
+
+#include "../common/image_handle.h"
+
+// Forward declaration
+class ResourcesSystem;
+
+// Decoded source images keyed by file path, so a sheet shared by many assets is
+// read from disk once. Cached images are released with the cache; callers keep
+// what they need by cropping copies out of them.
+class ImageCache {
+public:
+  explicit ImageCache(ResourcesSystem&);
+  ~ImageCache();
+
+  ImageCache(const ImageCache&) = delete;
+  ImageCache& operator=(const ImageCache&) = delete;
+
+  ImageHandle Get(const std::string& path);
+  void Clear();
+
+private:
+  ResourcesSystem& resources;
+  std::unordered_map<std::string, ImageHandle> images;
+};
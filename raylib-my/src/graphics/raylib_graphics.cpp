@@ -1,36 +1,31 @@
 #include "raylib_graphics.h"
 
-#include <unordered_map>
+#include <algorithm>
+#include <cmath>
 
 #include "raylib.h"
+#include "rlgl.h"
 #include "../common/game_error.h"
+#include "raylib_helpers.h"
+#include "slot_map.h"
 
 // PImpl implementation to keep Raylib types out of the public header
 struct RaylibGraphics::Impl {
-  std::unordered_map<uint32_t, Texture2D> textures;
-  std::unordered_map<uint32_t, Image> images;
-  uint32_t nextTextureId = 1;
-  uint32_t nextImageId = 1;
+  // Render targets keep their framebuffer next to the color texture that gets drawn
+  struct GpuTexture {
+    Texture2D texture;
+    RenderTexture2D target;
+    bool renderTarget;
+  };
+
+  SlotMap<GpuTexture> textures;
+  SlotMap<Image> images;
+  SlotMap<Mesh> meshes;
   Camera2D lastCamera;
+  Material meshMaterial;
+  bool meshMaterialLoaded = false;
 };
 
-// Helper functions for converting between our types and raylib types
-static Vector2 ToRaylibVector2(const Position2D& pos) {
-  return Vector2 { pos.x, pos.y };
-}
-
-static Position2D FromRaylibVector2(const Vector2& vec) {
-  return Position2D { vec.x, vec.y };
-}
-
-static Color ToRaylibColor(const Color2D& color) {
-  return Color { color.r, color.g, color.b, color.a };
-}
-
-static Rectangle ToRaylibRectangle(const Rectangle2D& rect) {
-  return Rectangle { rect.x, rect.y, rect.width, rect.height };
-}
-
 RaylibGraphics::RaylibGraphics(int s_w, int s_h, float t_w, float t_h, const std::string t, int fr):
   ScreenWidth { s_w },
   ScreenHeight { s_h },
@@ -41,6 +36,7 @@ RaylibGraphics::RaylibGraphics(int s_w, int s_h, float t_w, float t_h, const std
   Initialized { false },
   Correction { Position2D {.0f, 0.0f} },
   camera { { ScreenWidth / 2.0f, ScreenHeight / 4.0f }, { 0.0f, 0.0f }, 0.0f, 1.0f },
+  projection { t_w, t_h },
   impl { std::make_unique<Impl>() }
 {}
 
@@ -109,7 +105,13 @@ void RaylibGraphics::ClearBackground(Color2D color) {
 
 void RaylibGraphics::DrawTexture(TextureHandle textureHandle, Position2D position, Color2D tint, float scale) {
   if (!textureHandle.IsValid()) return;
-  const Texture2D& tex = impl->textures.at(textureHandle.GetId());
+  const Impl::GpuTexture& gpuTexture = impl->textures.At(textureHandle.GetId());
+  const Texture2D& tex = gpuTexture.texture;
+  if (gpuTexture.renderTarget) {
+    DrawTexturePro(textureHandle, { 0.0f, 0.0f, float(tex.width), float(tex.height) },
+                   { position.x, position.y, tex.width * scale, tex.height * scale }, tint);
+    return;
+  }
   Color raylibTint = ToRaylibColor(tint);
   if (scale == 1.0f) {
     ::DrawTexture(tex, (int)position.x, (int)position.y, raylibTint);
@@ -118,6 +120,17 @@ void RaylibGraphics::DrawTexture(TextureHandle textureHandle, Position2D positio
   }
 }
 
+void RaylibGraphics::DrawTexturePro(TextureHandle textureHandle, Rectangle2D srcRect, Rectangle2D dstRect, Color2D tint) {
+  if (!textureHandle.IsValid()) return;
+  const Impl::GpuTexture& gpuTexture = impl->textures.At(textureHandle.GetId());
+  const Texture2D& tex = gpuTexture.texture;
+  if (gpuTexture.renderTarget) {
+    // Render textures are stored bottom-up; a negative height samples them upright
+    srcRect = { srcRect.x, tex.height - srcRect.y - srcRect.height, srcRect.width, -srcRect.height };
+  }
+  ::DrawTexturePro(tex, ToRaylibRectangle(srcRect), ToRaylibRectangle(dstRect), Vector2 { 0.0f, 0.0f }, 0.0f, ToRaylibColor(tint));
+}
+
 void RaylibGraphics::DrawText(const char* text, Position2D position, int fontSize, Color2D color) {
   Color raylibColor = ToRaylibColor(color);
   ::DrawText(text, (int)position.x, (int)position.y, fontSize, raylibColor);
@@ -127,6 +140,10 @@ void RaylibGraphics::DrawFPS(int x, int y) {
   ::DrawFPS(x, y);
 }
 
+void RaylibGraphics::SetLayer(RenderLayer::Layer) {
+  // Immediate mode: submission order already is the draw order
+}
+
 void RaylibGraphics::SetDst(ImageHandle dst) {
   Dst = dst;
 }
@@ -137,98 +154,231 @@ void RaylibGraphics::SetCorrection(Position2D correction) {
 
 TextureHandle RaylibGraphics::LoadTexture(const char* filename) {
   Texture2D tex = ::LoadTexture(filename);
-  uint32_t id = impl->nextTextureId++;
-  impl->textures[id] = tex;
-  return TextureHandle(id);
+  return TextureHandle(impl->textures.Insert({ tex, {}, false }));
 }
 
 ImageHandle RaylibGraphics::LoadImage(const char* filename) {
   Image img = ::LoadImage(filename);
-  uint32_t id = impl->nextImageId++;
-  impl->images[id] = img;
-  return ImageHandle(id);
+  return ImageHandle(impl->images.Insert(img));
 }
 
 ImageHandle RaylibGraphics::LoadImageFromTexture(TextureHandle textureHandle) {
-  const Texture2D& tex = impl->textures.at(textureHandle.GetId());
+  const Texture2D& tex = impl->textures.At(textureHandle.GetId()).texture;
   Image img = ::LoadImageFromTexture(tex);
-  uint32_t id = impl->nextImageId++;
-  impl->images[id] = img;
-  return ImageHandle(id);
+  return ImageHandle(impl->images.Insert(img));
 }
 
 TextureHandle RaylibGraphics::LoadTextureFromImage(ImageHandle imageHandle) {
-  const Image& img = impl->images.at(imageHandle.GetId());
+  const Image& img = impl->images.At(imageHandle.GetId());
   Texture2D tex = ::LoadTextureFromImage(img);
-  uint32_t id = impl->nextTextureId++;
-  impl->textures[id] = tex;
-  return TextureHandle(id);
+  return TextureHandle(impl->textures.Insert({ tex, {}, false }));
 }
 
 void RaylibGraphics::UnloadTexture(TextureHandle textureHandle) {
   if (!textureHandle.IsValid()) return;
-  auto it = impl->textures.find(textureHandle.GetId());
-  if (it != impl->textures.end()) {
-    ::UnloadTexture(it->second);
-    impl->textures.erase(it);
+  Impl::GpuTexture* gpuTexture = impl->textures.Find(textureHandle.GetId());
+  if (!gpuTexture) return;
+
+  if (gpuTexture->renderTarget) {
+    ::UnloadRenderTexture(gpuTexture->target);
+  } else {
+    ::UnloadTexture(gpuTexture->texture);
   }
+  impl->textures.Erase(textureHandle.GetId());
 }
 
 void RaylibGraphics::UnloadImage(ImageHandle imageHandle) {
   if (!imageHandle.IsValid()) return;
-  auto it = impl->images.find(imageHandle.GetId());
-  if (it != impl->images.end()) {
-    ::UnloadImage(it->second);
-    impl->images.erase(it);
+  Image* img = impl->images.Find(imageHandle.GetId());
+  if (!img) return;
+
+  ::UnloadImage(*img);
+  impl->images.Erase(imageHandle.GetId());
+}
+
+void RaylibGraphics::UpdateTextureRegion(TextureHandle textureHandle, ImageHandle imageHandle, Rectangle2D region) {
+  if (!textureHandle.IsValid() || !imageHandle.IsValid()) return;
+  const Texture2D& tex = impl->textures.At(textureHandle.GetId()).texture;
+  const Image& img = impl->images.At(imageHandle.GetId());
+  if (img.format != tex.format) {
+    throw GameError("Texture region update requires matching image and texture formats");
   }
+
+  Rectangle raylibRegion = ClampToImage(region, img);
+  if (raylibRegion.width <= 0.0f || raylibRegion.height <= 0.0f) return;
+
+  // UpdateTextureRec expects tightly packed pixels of the region only
+  Image regionImage = ::ImageFromImage(img, raylibRegion);
+  ::UpdateTextureRec(tex, raylibRegion, regionImage.data);
+  ::UnloadImage(regionImage);
 }
 
 void RaylibGraphics::ImageCrop(ImageHandle& imageHandle, Rectangle2D rect) {
   if (!imageHandle.IsValid()) return;
-  Image& img = impl->images.at(imageHandle.GetId());
+  Image& img = impl->images.At(imageHandle.GetId());
   Rectangle raylibRect = ToRaylibRectangle(rect);
   ::ImageCrop(&img, raylibRect);
 }
 
+ImageHandle RaylibGraphics::ImageFromImage(ImageHandle imageHandle, Rectangle2D rect) {
+  const Image& img = impl->images.At(imageHandle.GetId());
+  Image region = ::ImageFromImage(img, ClampToImage(rect, img));
+  return ImageHandle(impl->images.Insert(region));
+}
+
 void RaylibGraphics::ImageDraw(ImageHandle dstHandle, ImageHandle srcHandle, Rectangle2D srcRect, Rectangle2D dstRect, Color2D tint) {
   if (!dstHandle.IsValid() || !srcHandle.IsValid()) return;
-  Image& dst = impl->images.at(dstHandle.GetId());
-  const Image& src = impl->images.at(srcHandle.GetId());
+  Image& dst = impl->images.At(dstHandle.GetId());
+  const Image& src = impl->images.At(srcHandle.GetId());
   Rectangle raylibSrcRect = ToRaylibRectangle(srcRect);
   Rectangle raylibDstRect = ToRaylibRectangle(dstRect);
   Color raylibTint = ToRaylibColor(tint);
   ::ImageDraw(&dst, src, raylibSrcRect, raylibDstRect, raylibTint);
 }
 
+void RaylibGraphics::ImageBlit(ImageHandle dstHandle, ImageHandle srcHandle, Position2D position) {
+  if (!dstHandle.IsValid() || !srcHandle.IsValid()) return;
+  BlitImage(impl->images.At(dstHandle.GetId()), impl->images.At(srcHandle.GetId()), position);
+}
+
+void RaylibGraphics::ImageDownsample(ImageHandle srcHandle, ImageHandle dstHandle, Rectangle2D dstRegion) {
+  if (!srcHandle.IsValid() || !dstHandle.IsValid()) return;
+  const Image& src = impl->images.At(srcHandle.GetId());
+  Image& dst = impl->images.At(dstHandle.GetId());
+  DownsampleImage(src, dst, dstRegion);
+}
+
 void RaylibGraphics::ImageDrawLineEx(ImageHandle dstHandle, Position2D start, Position2D end, float thickness, Color2D color) {
   if (!dstHandle.IsValid()) return;
-  Image& dst = impl->images.at(dstHandle.GetId());
+  Image& dst = impl->images.At(dstHandle.GetId());
   Vector2 raylibStart = ToRaylibVector2(start);
   Vector2 raylibEnd = ToRaylibVector2(end);
   Color raylibColor = ToRaylibColor(color);
   ::ImageDrawLineEx(&dst, raylibStart, raylibEnd, (int)thickness, raylibColor);
 }
 
+void RaylibGraphics::ImageDrawPixel(ImageHandle dstHandle, int x, int y, Color2D color) {
+  if (!dstHandle.IsValid()) return;
+  ::ImageDrawPixel(&impl->images.At(dstHandle.GetId()), x, y, ToRaylibColor(color));
+}
+
 ImageHandle RaylibGraphics::GenImageColor(float width, float height, Color2D color) {
   Color raylibColor = ToRaylibColor(color);
   Image img = ::GenImageColor((int)width, (int)height, raylibColor);
-  uint32_t id = impl->nextImageId++;
-  impl->images[id] = img;
-  return ImageHandle(id);
+  return ImageHandle(impl->images.Insert(img));
+}
+
+ResourceMemoryStats RaylibGraphics::MemoryStats() const {
+  ResourceMemoryStats stats;
+  impl->images.ForEach([&stats](const Image& img) {
+    ++stats.images;
+    stats.imageBytes += ::GetPixelDataSize(img.width, img.height, img.format);
+  });
+  // Mipmaps are never generated, so the base level is the whole texture
+  impl->textures.ForEach([&stats](const Impl::GpuTexture& gpuTexture) {
+    const Texture2D& tex = gpuTexture.texture;
+    ++stats.textures;
+    stats.textureBytes += ::GetPixelDataSize(tex.width, tex.height, tex.format);
+  });
+  return stats;
 }
 
 int RaylibGraphics::GetImageWidth(ImageHandle handle) const {
   if (!handle.IsValid()) return 0;
-  const Image& img = impl->images.at(handle.GetId());
+  const Image& img = impl->images.At(handle.GetId());
   return img.width;
 }
 
 int RaylibGraphics::GetImageHeight(ImageHandle handle) const {
   if (!handle.IsValid()) return 0;
-  const Image& img = impl->images.at(handle.GetId());
+  const Image& img = impl->images.At(handle.GetId());
   return img.height;
 }
 
+int RaylibGraphics::GetTextureWidth(TextureHandle handle) const {
+  if (!handle.IsValid()) return 0;
+  return impl->textures.At(handle.GetId()).texture.width;
+}
+
+int RaylibGraphics::GetTextureHeight(TextureHandle handle) const {
+  if (!handle.IsValid()) return 0;
+  return impl->textures.At(handle.GetId()).texture.height;
+}
+
+TextureHandle RaylibGraphics::LoadRenderTexture(int width, int height) {
+  RenderTexture2D target = ::LoadRenderTexture(width, height);
+  return TextureHandle(impl->textures.Insert({ target.texture, target, true }));
+}
+
+void RaylibGraphics::BeginTextureMode(TextureHandle targetHandle) {
+  const Impl::GpuTexture& gpuTexture = impl->textures.At(targetHandle.GetId());
+  if (!gpuTexture.renderTarget) {
+    throw GameError("Texture mode requires a texture created by LoadRenderTexture");
+  }
+  ::BeginTextureMode(gpuTexture.target);
+}
+
+void RaylibGraphics::EndTextureMode() {
+  ::EndTextureMode();
+}
+
+MeshHandle RaylibGraphics::LoadMesh(const std::vector<Position2D>& vertices, const std::vector<Position2D>& texcoords,
+                                    const std::vector<uint16_t>& indices) {
+  if (vertices.empty() || vertices.size() != texcoords.size() || indices.size() % 3 != 0) {
+    throw GameError("Mesh requires matching vertex/texcoord counts and whole triangles");
+  }
+
+  // Buffers are released by ::UnloadMesh, so they must come from raylib's allocator
+  Mesh mesh {};
+  mesh.vertexCount = static_cast<int>(vertices.size());
+  mesh.triangleCount = static_cast<int>(indices.size() / 3);
+  mesh.vertices = static_cast<float*>(MemAlloc(vertices.size() * 3 * sizeof(float)));
+  mesh.texcoords = static_cast<float*>(MemAlloc(texcoords.size() * 2 * sizeof(float)));
+  mesh.indices = static_cast<unsigned short*>(MemAlloc(indices.size() * sizeof(unsigned short)));
+
+  for (size_t i = 0; i < vertices.size(); ++i) {
+    mesh.vertices[3 * i] = vertices[i].x;
+    mesh.vertices[3 * i + 1] = vertices[i].y;
+    mesh.vertices[3 * i + 2] = 0.0f;
+    mesh.texcoords[2 * i] = texcoords[i].x;
+    mesh.texcoords[2 * i + 1] = texcoords[i].y;
+  }
+  std::copy(indices.begin(), indices.end(), mesh.indices);
+
+  ::UploadMesh(&mesh, false);
+  return MeshHandle(impl->meshes.Insert(mesh));
+}
+
+void RaylibGraphics::DrawMesh(MeshHandle meshHandle, TextureHandle textureHandle) {
+  if (!meshHandle.IsValid() || !textureHandle.IsValid()) return;
+  if (!impl->meshMaterialLoaded) {
+    impl->meshMaterial = ::LoadMaterialDefault();
+    impl->meshMaterialLoaded = true;
+  }
+
+  const Mesh& mesh = impl->meshes.At(meshHandle.GetId());
+  impl->meshMaterial.maps[MATERIAL_MAP_DIFFUSE].texture = impl->textures.At(textureHandle.GetId()).texture;
+  Matrix identity = { 1.0f, 0.0f, 0.0f, 0.0f,
+                      0.0f, 1.0f, 0.0f, 0.0f,
+                      0.0f, 0.0f, 1.0f, 0.0f,
+                      0.0f, 0.0f, 0.0f, 1.0f };
+
+  // Mesh draws bypass the batch, so flush pending 2D draws to keep painter's order.
+  // The 2D camera flips Y, which reverses triangle winding.
+  rlDrawRenderBatchActive();
+  rlDisableBackfaceCulling();
+  ::DrawMesh(mesh, impl->meshMaterial, identity);
+  rlEnableBackfaceCulling();
+}
+
+void RaylibGraphics::UnloadMesh(MeshHandle meshHandle) {
+  if (!meshHandle.IsValid()) return;
+  Mesh* mesh = impl->meshes.Find(meshHandle.GetId());
+  if (!mesh) return;
+
+  ::UnloadMesh(*mesh);
+  impl->meshes.Erase(meshHandle.GetId());
+}
 
 void RaylibGraphics::DrawRectangle(Rectangle2D rect, Color2D color) {
   Color raylibColor = ToRaylibColor(color);
@@ -236,20 +386,11 @@ void RaylibGraphics::DrawRectangle(Rectangle2D rect, Color2D color) {
 }
 
 Position2D RaylibGraphics::GridToScreen(Position2D pos) {
-  float sx = (pos.x - pos.y) * TileWidth * 0.5f;
-  float sy = (pos.x + pos.y) * TileHeight * 0.5f;
-
-  return { sx, sy };
+  return projection.GridToWorld(pos);
 }
 
 Position2D RaylibGraphics::ScreenToWorld2D(Position2D world) {
-  float a = world.x / (TileWidth * 0.5f);
-  float b = world.y / (TileHeight * 0.5f);
-
-  float gx = (a + b) * 0.5f;
-  float gy = (b - a) * 0.5f;
-
-  return { floor(gx), floor(gy) }; // fractional; need to floor/round it
+  return projection.WorldToTile(world);
 }
 
 Position2D RaylibGraphics::MouseToWorld2D() {
@@ -259,6 +400,10 @@ Position2D RaylibGraphics::MouseToWorld2D() {
   return ScreenToWorld2D(FromRaylibVector2(world));
 }
 
+TileRange RaylibGraphics::VisibleTileRange(int mapWidth, int mapHeight) const {
+  return projection.VisibleTileRange(camera, ScreenWidth, ScreenHeight, mapWidth, mapHeight);
+}
+
 Position2D RaylibGraphics::ScreenToWorldWithCamera(const GrphCamera& grphCamera) {
   Vector2 mousePos = ::GetMousePosition();
   Camera2D raylibCam = {
@@ -281,7 +426,7 @@ void RaylibGraphics::DrawDiamondFrame(Position2D center, Color2D color, bool dst
 
   if (dst && Dst.IsValid()) {
     // Draw to image using handle
-    Image& dstImage = impl->images.at(Dst.GetId());
+    Image& dstImage = impl->images.At(Dst.GetId());
     ::ImageDrawLineEx(&dstImage, top, right, (int)thickness, raylibColor);
     ::ImageDrawLineEx(&dstImage, right, bottom, (int)thickness, raylibColor);
     ::ImageDrawLineEx(&dstImage, bottom, left, (int)thickness, raylibColor);
@@ -301,11 +446,24 @@ void RaylibGraphics::DrawDiamondFrame(Position2D center, Color2D color, bool dst
   }
 }
 
+void RaylibGraphics::DrawLine(Position2D start, Position2D end, Color2D color, float thickness) {
+  if (thickness <= 1.0f) {
+    DrawLineV(ToRaylibVector2(start), ToRaylibVector2(end), ToRaylibColor(color));
+  } else {
+    DrawLineEx(ToRaylibVector2(start), ToRaylibVector2(end), thickness, ToRaylibColor(color));
+  }
+}
+
 bool RaylibGraphics::Done() {
   return WindowShouldClose();
 }
 
 RaylibGraphics::~RaylibGraphics() {
+  if (impl->meshMaterialLoaded) {
+    // The diffuse map only borrows a texture, which the texture slots release
+    impl->meshMaterial.maps[MATERIAL_MAP_DIFFUSE].texture.id = rlGetTextureIdDefault();
+    ::UnloadMaterial(impl->meshMaterial);
+  }
   CloseWindow();
 }
 
@@ -12,9 +12,12 @@
 #include "../common/color_2d.h"
 #include "../common/grph_camera.h"
 #include "../common/image_handle.h"
+#include "../common/iso_projection.h"
+#include "../common/mesh_handle.h"
 #include "../common/position_2d.h"
 #include "../common/rectangle_2d.h"
 #include "../common/texture_handle.h"
+#include "../common/tile_range.h"
 
 class RaylibGraphics : public InputSystem,
                        public CollisionSystem,
@@ -54,25 +57,40 @@ public:
   void EndMode2D() override;
   void DrawRectangle(Rectangle2D rect, Color2D color) override;
   void DrawDiamondFrame(Position2D center, Color2D color, bool dst, float thickness) override;
+  void DrawLine(Position2D start, Position2D end, Color2D color, float thickness) override;
   void UpdateGrphCamera(const GrphCamera& camera) override;
   const GrphCamera& GetGrphCamera() const override;
   Position2D GridToScreen(Position2D pos) override;
   Position2D ScreenToWorld2D(Position2D screenPos) override;
   Position2D ScreenToWorldWithCamera(const GrphCamera& camera) override;
   Position2D MouseToWorld2D() override;
+  TileRange VisibleTileRange(int mapWidth, int mapHeight) const override;
   float GetTileWidth() const override;
   float GetTileHeight() const override;
   Position2D GetCorrection() const override;
   ImageHandle GetDst() const override;
   void ImageDraw(ImageHandle dst, ImageHandle src, Rectangle2D srcRect, Rectangle2D dstRect, Color2D tint) override;
+  void ImageBlit(ImageHandle dst, ImageHandle src, Position2D position) override;
+  void ImageDownsample(ImageHandle src, ImageHandle dst, Rectangle2D dstRegion) override;
   int GetImageWidth(ImageHandle image) const override;
   int GetImageHeight(ImageHandle image) const override;
+  int GetTextureWidth(TextureHandle texture) const override;
+  int GetTextureHeight(TextureHandle texture) const override;
   void ClearBackground(Color2D color) override;
   void DrawTexture(TextureHandle texture, Position2D position, Color2D tint, float scale = 1.0f) override;
+  void DrawTexturePro(TextureHandle texture, Rectangle2D srcRect, Rectangle2D dstRect, Color2D tint) override;
   void DrawText(const char* text, Position2D position, int fontSize, Color2D color) override;
   void DrawFPS(int x, int y) override;
+  void SetLayer(RenderLayer::Layer layer) override;
   void SetDst(ImageHandle dst) override;
   void SetCorrection(Position2D correction) override;
+  TextureHandle LoadRenderTexture(int width, int height) override;
+  void BeginTextureMode(TextureHandle target) override;
+  void EndTextureMode() override;
+  MeshHandle LoadMesh(const std::vector<Position2D>& vertices, const std::vector<Position2D>& texcoords,
+                      const std::vector<uint16_t>& indices) override;
+  void DrawMesh(MeshHandle mesh, TextureHandle texture) override;
+  void UnloadMesh(MeshHandle mesh) override;
 
   // ResourcesSystem interface implementation
   TextureHandle LoadTexture(const char* filename) override;
@@ -81,12 +99,17 @@ public:
   TextureHandle LoadTextureFromImage(ImageHandle image) override;
   void UnloadTexture(TextureHandle texture) override;
   void UnloadImage(ImageHandle image) override;
+  void UpdateTextureRegion(TextureHandle texture, ImageHandle image, Rectangle2D region) override;
   void ImageCrop(ImageHandle& image, Rectangle2D rect) override;
+  ImageHandle ImageFromImage(ImageHandle image, Rectangle2D rect) override;
   void ImageDrawLineEx(ImageHandle dst, Position2D start, Position2D end, float thickness, Color2D color) override;
+  void ImageDrawPixel(ImageHandle dst, int x, int y, Color2D color) override;
   ImageHandle GenImageColor(float width, float height, Color2D color) override;
+  ResourceMemoryStats MemoryStats() const override;
 
 private:
   GrphCamera camera;
+  IsoProjection projection;
   struct Impl;
   std::unique_ptr<Impl> impl;
   void* ConvertToRaylibCamera();
@@ -0,0 +1,85 @@
+#include "raylib_helpers.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "../common/game_error.h"
+#include "rgba8_blit.h"
+
+Vector2 ToRaylibVector2(const Position2D& pos) {
+  return Vector2 { pos.x, pos.y };
+}
+
+Position2D FromRaylibVector2(const Vector2& vec) {
+  return Position2D { vec.x, vec.y };
+}
+
+Color ToRaylibColor(const Color2D& color) {
+  return Color { color.r, color.g, color.b, color.a };
+}
+
+Rectangle ToRaylibRectangle(const Rectangle2D& rect) {
+  return Rectangle { rect.x, rect.y, rect.width, rect.height };
+}
+
+Rectangle ClampToImage(const Rectangle2D& rect, const Image& img) {
+  float minX = std::max(0.0f, std::floor(rect.x));
+  float minY = std::max(0.0f, std::floor(rect.y));
+  float maxX = std::min(static_cast<float>(img.width), std::ceil(rect.x + rect.width));
+  float maxY = std::min(static_cast<float>(img.height), std::ceil(rect.y + rect.height));
+  return Rectangle { minX, minY, std::max(0.0f, maxX - minX), std::max(0.0f, maxY - minY) };
+}
+
+void BlitImage(Image& dst, const Image& src, Position2D position) {
+  if (src.format != PIXELFORMAT_UNCOMPRESSED_R8G8B8A8 || dst.format != PIXELFORMAT_UNCOMPRESSED_R8G8B8A8) {
+    ::ImageDraw(&dst, src, Rectangle { 0.0f, 0.0f, float(src.width), float(src.height) },
+                Rectangle { position.x, position.y, float(src.width), float(src.height) }, WHITE);
+    return;
+  }
+
+  int x = static_cast<int>(std::floor(position.x));
+  int y = static_cast<int>(std::floor(position.y));
+  int srcX = std::max(0, -x);
+  int srcY = std::max(0, -y);
+  int width = std::min(src.width, dst.width - x) - srcX;
+  int height = std::min(src.height, dst.height - y) - srcY;
+  if (width <= 0 || height <= 0) return;
+
+  unsigned char* dstPixels = static_cast<unsigned char*>(dst.data) + 4 * ((y + srcY) * dst.width + x + srcX);
+  const unsigned char* srcPixels = static_cast<const unsigned char*>(src.data) + 4 * (srcY * src.width + srcX);
+  BlitRGBA8(dstPixels, dst.width, srcPixels, src.width, width, height);
+}
+
+void DownsampleImage(const Image& src, Image& dst, Rectangle2D dstRegion) {
+  if (src.format != PIXELFORMAT_UNCOMPRESSED_R8G8B8A8 || dst.format != PIXELFORMAT_UNCOMPRESSED_R8G8B8A8) {
+    throw GameError("Image downsample supports RGBA8 images only");
+  }
+
+  Rectangle region = ClampToImage(dstRegion, dst);
+  const unsigned char* srcPixels = static_cast<const unsigned char*>(src.data);
+  unsigned char* dstPixels = static_cast<unsigned char*>(dst.data);
+  int maxX = static_cast<int>(region.x + region.width);
+  int maxY = static_cast<int>(region.y + region.height);
+
+  // 2x2 box filter weighted by alpha so transparent texels don't darken diamond edges
+  for (int y = static_cast<int>(region.y); y < maxY; ++y) {
+    for (int x = static_cast<int>(region.x); x < maxX; ++x) {
+      unsigned int r = 0, g = 0, b = 0, a = 0;
+      for (int sy = 2 * y; sy < std::min(2 * y + 2, src.height); ++sy) {
+        for (int sx = 2 * x; sx < std::min(2 * x + 2, src.width); ++sx) {
+          const unsigned char* p = srcPixels + 4 * (sy * src.width + sx);
+          r += p[0] * p[3];
+          g += p[1] * p[3];
+          b += p[2] * p[3];
+          a += p[3];
+        }
+      }
+
+      unsigned char* out = dstPixels + 4 * (y * dst.width + x);
+      out[0] = a ? static_cast<unsigned char>(r / a) : 0;
+      out[1] = a ? static_cast<unsigned char>(g / a) : 0;
+      out[2] = a ? static_cast<unsigned char>(b / a) : 0;
+      out[3] = static_cast<unsigned char>(a / 4);
+    }
+  }
+}
@@ -0,0 +1,23 @@
+#pragma once
+
+#include "raylib.h"
+#include "../common/color_2d.h"
+#include "../common/position_2d.h"
+#include "../common/rectangle_2d.h"
+
+// Conversions and CPU image routines shared by the raylib-based backends.
+// Only included from .cpp files so raylib types stay out of public headers.
+Vector2 ToRaylibVector2(const Position2D& pos);
+Position2D FromRaylibVector2(const Vector2& vec);
+Color ToRaylibColor(const Color2D& color);
+Rectangle ToRaylibRectangle(const Rectangle2D& rect);
+
+// Snaps rect outwards to whole pixels and clips it to the image bounds
+Rectangle ClampToImage(const Rectangle2D& rect, const Image& img);
+
+// Unscaled, untinted draw of src at (x, y). Uses the RGBA8 blit kernel when
+// both images are RGBA8 and falls back to ImageDraw otherwise.
+void BlitImage(Image& dst, const Image& src, Position2D position);
+
+// Fills dstRegion of dst from the matching 2x2 blocks of src; RGBA8 only
+void DownsampleImage(const Image& src, Image& dst, Rectangle2D dstRegion);
@@ -0,0 +1,20 @@
+#pragma once
+
+// Draw layers used to order recorded commands; lower layers are drawn first.
+// Commands within one layer may be reordered to group draws by texture.
+class RenderLayer {
+public:
+  using Layer = int;
+
+  static constexpr Layer Terrain = 0;
+  static constexpr Layer TerrainOverlay = 1;
+  static constexpr Layer Decorations = 2;
+  static constexpr Layer Cursor = 3;
+
+  static constexpr Layer UiBackground = 10;
+  static constexpr Layer UiRows = 11;
+  static constexpr Layer UiIcons = 12;
+  static constexpr Layer UiText = 13;
+
+  static constexpr Layer Debug = 20;
+};
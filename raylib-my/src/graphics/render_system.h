@@ -1,11 +1,17 @@
 #pragma once
 
+#include <cstdint>
+#include <vector>
+
 #include "../common/color_2d.h"
 #include "../common/grph_camera.h"
 #include "../common/image_handle.h"
+#include "../common/mesh_handle.h"
 #include "../common/position_2d.h"
 #include "../common/rectangle_2d.h"
 #include "../common/texture_handle.h"
+#include "../common/tile_range.h"
+#include "render_layer.h"
 
 class RenderSystem {
 public:
@@ -17,6 +23,7 @@ public:
   virtual void EndMode2D() = 0;
   virtual void DrawRectangle(Rectangle2D rect, Color2D color) = 0;
   virtual void DrawDiamondFrame(Position2D center, Color2D color, bool dst, float thickness) = 0;
+  virtual void DrawLine(Position2D start, Position2D end, Color2D color, float thickness) = 0;
 
   // Camera management
   virtual void UpdateGrphCamera(const GrphCamera& camera) = 0;
@@ -27,6 +34,7 @@ public:
   virtual Position2D ScreenToWorld2D(Position2D screenPos) = 0;
   virtual Position2D ScreenToWorldWithCamera(const GrphCamera& camera) = 0;
   virtual Position2D MouseToWorld2D() = 0;
+  virtual TileRange VisibleTileRange(int mapWidth, int mapHeight) const = 0;
 
   // Tile rendering properties (public members or getters)
   virtual float GetTileWidth() const = 0;
@@ -36,14 +44,23 @@ public:
 
   // Image operations needed for rendering
   virtual void ImageDraw(ImageHandle dst, ImageHandle src, Rectangle2D srcRect, Rectangle2D dstRect, Color2D tint) = 0;
+  // Unscaled, untinted draw; takes the SIMD blit path when both images are RGBA8
+  virtual void ImageBlit(ImageHandle dst, ImageHandle src, Position2D position) = 0;
+  virtual void ImageDownsample(ImageHandle src, ImageHandle dst, Rectangle2D dstRegion) = 0;
+  virtual void ImageDrawLineEx(ImageHandle dst, Position2D start, Position2D end, float thickness, Color2D color) = 0;
+  virtual void ImageDrawPixel(ImageHandle dst, int x, int y, Color2D color) = 0;
   virtual int GetImageWidth(ImageHandle image) const = 0;
   virtual int GetImageHeight(ImageHandle image) const = 0;
+  virtual int GetTextureWidth(TextureHandle texture) const = 0;
+  virtual int GetTextureHeight(TextureHandle texture) const = 0;
 
   // Rendering operations
   virtual void ClearBackground(Color2D color) = 0;
   virtual void DrawTexture(TextureHandle texture, Position2D position, Color2D tint, float scale = 1.0f) = 0;
+  virtual void DrawTexturePro(TextureHandle texture, Rectangle2D srcRect, Rectangle2D dstRect, Color2D tint) = 0;
   virtual void DrawText(const char* text, Position2D position, int fontSize, Color2D color) = 0;
   virtual void DrawFPS(int x, int y) = 0;
+  virtual void SetLayer(RenderLayer::Layer layer) = 0;
 
   // Tile rendering state management
   virtual void SetDst(ImageHandle dst) = 0;
@@ -53,4 +70,18 @@ public:
   virtual ImageHandle GenImageColor(float width, float height, Color2D color) = 0;
   virtual TextureHandle LoadTextureFromImage(ImageHandle image) = 0;
   virtual void UnloadTexture(TextureHandle texture) = 0;
+  virtual void UnloadImage(ImageHandle image) = 0;
+  virtual void UpdateTextureRegion(TextureHandle texture, ImageHandle image, Rectangle2D region) = 0;
+
+  // Offscreen target drawn like any other texture and released with UnloadTexture.
+  // Draws between Begin/EndTextureMode land in it in its own pixel coordinates.
+  virtual TextureHandle LoadRenderTexture(int width, int height) = 0;
+  virtual void BeginTextureMode(TextureHandle target) = 0;
+  virtual void EndTextureMode() = 0;
+
+  // Static geometry in world coordinates, texcoords normalized to the texture it is drawn with
+  virtual MeshHandle LoadMesh(const std::vector<Position2D>& vertices, const std::vector<Position2D>& texcoords,
+                              const std::vector<uint16_t>& indices) = 0;
+  virtual void DrawMesh(MeshHandle mesh, TextureHandle texture) = 0;
+  virtual void UnloadMesh(MeshHandle mesh) = 0;
 };
@@ -0,0 +1,13 @@
+#include "resource_memory_stats.h"
+
+#include <iomanip>
+#include <sstream>
+
+std::string ResourceMemoryStats::Describe() const {
+  constexpr double kMiB = 1024.0 * 1024.0;
+  std::ostringstream line;
+  line << std::fixed << std::setprecision(1)
+       << "CPU " << images << " images " << imageBytes / kMiB << " MiB, "
+       << "GPU " << textures << " textures " << textureBytes / kMiB << " MiB";
+  return line.str();
+}
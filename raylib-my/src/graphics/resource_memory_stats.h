@@ -0,0 +1,15 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+// Pixel memory held by a backend, split by where it lives
+struct ResourceMemoryStats {
+  int images = 0;
+  size_t imageBytes = 0;
+  int textures = 0;
+  size_t textureBytes = 0;
+
+  // One line, e.g. "CPU 12 images 1.5 MiB, GPU 40 textures 8.0 MiB"
+  std::string Describe() const;
+};
@@ -5,6 +5,7 @@
 #include "../common/position_2d.h"
 #include "../common/rectangle_2d.h"
 #include "../common/texture_handle.h"
+#include "resource_memory_stats.h"
 
 class ResourcesSystem {
 public:
@@ -16,10 +17,16 @@ public:
   virtual TextureHandle LoadTextureFromImage(ImageHandle image) = 0;
   virtual void UnloadTexture(TextureHandle texture) = 0;
   virtual void UnloadImage(ImageHandle image) = 0;
+  virtual void UpdateTextureRegion(TextureHandle texture, ImageHandle image, Rectangle2D region) = 0;
 
   // Image manipulation operations
   virtual void ImageCrop(ImageHandle& image, Rectangle2D rect) = 0;
+  // New image holding a copy of the region; the source stays untouched
+  virtual ImageHandle ImageFromImage(ImageHandle image, Rectangle2D rect) = 0;
   virtual void ImageDraw(ImageHandle dst, ImageHandle src, Rectangle2D srcRect, Rectangle2D dstRect, Color2D tint) = 0;
+  // Unscaled, untinted draw; takes the SIMD blit path when both images are RGBA8
+  virtual void ImageBlit(ImageHandle dst, ImageHandle src, Position2D position) = 0;
+  virtual void ImageDownsample(ImageHandle src, ImageHandle dst, Rectangle2D dstRegion) = 0;
   virtual void ImageDrawLineEx(ImageHandle dst, Position2D start, Position2D end, float thickness, Color2D color) = 0;
 
   virtual ImageHandle GenImageColor(float width, float height, Color2D color) = 0;
@@ -27,4 +34,5 @@ public:
   // Query methods
   virtual int GetImageWidth(ImageHandle image) const = 0;
   virtual int GetImageHeight(ImageHandle image) const = 0;
+  virtual ResourceMemoryStats MemoryStats() const = 0;
 };
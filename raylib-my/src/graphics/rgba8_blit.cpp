@@ -0,0 +1,106 @@
+#include "rgba8_blit.h"
+
+#include <cstring>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define BLIT_SSE2 1
+#endif
+
+namespace {
+
+inline void blendPixel(unsigned char* d, const unsigned char* s) {
+  unsigned int sa = s[3];
+  if (sa == 0) return;
+  if (sa == 255) {
+    std::memcpy(d, s, 4);
+    return;
+  }
+
+  // Integer form of raylib's ColorAlphaBlend: alpha + 1 lets >> 8 stand in for / 255
+  unsigned int alpha = sa + 1;
+  unsigned int outA = (alpha * 256 + d[3] * (256 - alpha)) >> 8;
+  if (outA > 0) {
+    for (int c = 0; c < 3; ++c) {
+      d[c] = static_cast<unsigned char>(((s[c] * alpha * 256 + d[c] * d[3] * (256 - alpha)) / outA) >> 8);
+    }
+  }
+  d[3] = static_cast<unsigned char>(outA);
+}
+
+inline void blendRow(unsigned char* d, const unsigned char* s, int count) {
+  for (int x = 0; x < count; ++x) {
+    blendPixel(d + 4 * x, s + 4 * x);
+  }
+}
+
+}
+
+void BlitRGBA8Scalar(unsigned char* dst, int dstStride, const unsigned char* src, int srcStride, int width, int height) {
+  for (int y = 0; y < height; ++y) {
+    blendRow(dst + 4 * y * dstStride, src + 4 * y * srcStride, width);
+  }
+}
+
+// Tile sprites are mostly fully opaque or fully transparent; only the diamond
+// edges need a real blend. The vector loop classifies whole groups of pixels
+// by alpha and copies or skips them, falling back to scalar for mixed groups.
+void BlitRGBA8(unsigned char* dst, int dstStride, const unsigned char* src, int srcStride, int width, int height) {
+#if defined(__AVX2__)
+  const __m256i opaque = _mm256_set1_epi32(255);
+  const __m256i clear = _mm256_setzero_si256();
+  for (int y = 0; y < height; ++y) {
+    unsigned char* d = dst + 4 * y * dstStride;
+    const unsigned char* s = src + 4 * y * srcStride;
+    int x = 0;
+    for (; x + 8 <= width; x += 8) {
+      __m256i pixels = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s + 4 * x));
+      __m256i alpha = _mm256_srli_epi32(pixels, 24);
+      int opaqueMask = _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(alpha, opaque)));
+      if (opaqueMask == 0xFF) {
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(d + 4 * x), pixels);
+        continue;
+      }
+      int clearMask = _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(alpha, clear)));
+      if (clearMask == 0xFF) continue;
+      blendRow(d + 4 * x, s + 4 * x, 8);
+    }
+    blendRow(d + 4 * x, s + 4 * x, width - x);
+  }
+#elif defined(BLIT_SSE2)
+  const __m128i opaque = _mm_set1_epi32(255);
+  const __m128i clear = _mm_setzero_si128();
+  for (int y = 0; y < height; ++y) {
+    unsigned char* d = dst + 4 * y * dstStride;
+    const unsigned char* s = src + 4 * y * srcStride;
+    int x = 0;
+    for (; x + 4 <= width; x += 4) {
+      __m128i pixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + 4 * x));
+      __m128i alpha = _mm_srli_epi32(pixels, 24);
+      int opaqueMask = _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(alpha, opaque)));
+      if (opaqueMask == 0xF) {
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(d + 4 * x), pixels);
+        continue;
+      }
+      int clearMask = _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(alpha, clear)));
+      if (clearMask == 0xF) continue;
+      blendRow(d + 4 * x, s + 4 * x, 4);
+    }
+    blendRow(d + 4 * x, s + 4 * x, width - x);
+  }
+#else
+  BlitRGBA8Scalar(dst, dstStride, src, srcStride, width, height);
+#endif
+}
+
+const char* BlitRGBA8Variant() {
+#if defined(__AVX2__)
+  return "avx2";
+#elif defined(BLIT_SSE2)
+  return "sse2";
+#else
+  return "scalar";
+#endif
+}
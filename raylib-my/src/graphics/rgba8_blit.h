@@ -0,0 +1,10 @@
+#pragma once
+
+// Source-over blend of a width x height block of RGBA8 pixels into dst.
+// Strides are in pixels. Rounding matches raylib's ColorAlphaBlend with a
+// white tint, so results are identical to ImageDraw on RGBA8 images.
+// The SIMD variant is chosen at compile time: AVX2 when the build enables
+// it, SSE2 on any x86-64 target, scalar elsewhere.
+void BlitRGBA8(unsigned char* dst, int dstStride, const unsigned char* src, int srcStride, int width, int height);
+void BlitRGBA8Scalar(unsigned char* dst, int dstStride, const unsigned char* src, int srcStride, int width, int height);
+const char* BlitRGBA8Variant();
@@ -0,0 +1,112 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "../common/game_error.h"
+
+// Dense storage behind resource handles. An id packs a slot index with the slot's
+// generation, so lookups are a bounds check plus an array access, and ids of
+// unloaded resources are rejected instead of aliasing whatever reused the slot.
+// Id 0 is never issued, matching the invalid handle, and neither is the all-ones id
+// the command buffer uses for the font.
+template <typename T>
+class SlotMap {
+public:
+  uint32_t Insert(T value) {
+    uint32_t index;
+    if (!freeSlots.empty()) {
+      index = freeSlots.back();
+      freeSlots.pop_back();
+    } else {
+      if (slots.size() >= maxSlots) {
+        throw GameError("Resource slot map is full");
+      }
+      index = static_cast<uint32_t>(slots.size());
+      slots.push_back({});
+    }
+
+    Slot& slot = slots[index];
+    slot.value = std::move(value);
+    slot.occupied = true;
+    ++count;
+    return (slot.generation << indexBits) | (index + 1);
+  }
+
+  // Null for ids that were never issued or whose resource is already gone
+  T* Find(uint32_t id) {
+    Slot* slot = slotFor(id);
+    return slot ? &slot->value : nullptr;
+  }
+
+  const T* Find(uint32_t id) const {
+    return const_cast<SlotMap*>(this)->Find(id);
+  }
+
+  T& At(uint32_t id) {
+    T* value = Find(id);
+    if (!value) {
+      throw GameError("Stale or unknown resource handle " + std::to_string(id));
+    }
+    return *value;
+  }
+
+  const T& At(uint32_t id) const {
+    return const_cast<SlotMap*>(this)->At(id);
+  }
+
+  bool Contains(uint32_t id) const {
+    return Find(id) != nullptr;
+  }
+
+  // Returns false when the id is already stale, so double unloads stay harmless
+  bool Erase(uint32_t id) {
+    Slot* slot = slotFor(id);
+    if (!slot) return false;
+
+    slot->value = T {};
+    slot->occupied = false;
+    slot->generation = (slot->generation + 1) & generationMask;
+    freeSlots.push_back((id & indexMask) - 1);
+    --count;
+    return true;
+  }
+
+  template <typename Visitor>
+  void ForEach(Visitor visitor) {
+    for (Slot& slot : slots) {
+      if (slot.occupied) visitor(slot.value);
+    }
+  }
+
+  size_t Size() const {
+    return count;
+  }
+
+private:
+  static constexpr uint32_t indexBits = 20;
+  static constexpr uint32_t indexMask = (1u << indexBits) - 1;
+  static constexpr uint32_t generationMask = (1u << (32 - indexBits)) - 1;
+  static constexpr size_t maxSlots = indexMask - 1;
+
+  struct Slot {
+    T value {};
+    uint32_t generation = 0;
+    bool occupied = false;
+  };
+
+  Slot* slotFor(uint32_t id) {
+    uint32_t index = (id & indexMask);
+    if (index == 0 || index > slots.size()) return nullptr;
+
+    Slot& slot = slots[index - 1];
+    if (!slot.occupied || slot.generation != (id >> indexBits)) return nullptr;
+    return &slot;
+  }
+
+  std::vector<Slot> slots;
+  std::vector<uint32_t> freeSlots;
+  size_t count = 0;
+};
@@ -2,4 +2,6 @@
 
 GraphicsComponent::GraphicsComponent() {}
 
+void GraphicsComponent::Unload(RenderSystem&) {}
+
 GraphicsComponent::~GraphicsComponent() {}
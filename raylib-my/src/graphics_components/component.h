@@ -8,5 +8,7 @@ class GraphicsComponent {
 public:
     GraphicsComponent();
     virtual void Render(GameObject&, RenderSystem&) = 0;
+    // Frees whatever Render uploaded; called by the owner before the backend goes away
+    virtual void Unload(RenderSystem&);
     virtual ~GraphicsComponent();
 };
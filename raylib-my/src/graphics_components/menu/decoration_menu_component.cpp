@@ -9,31 +9,64 @@
 #include "../../services/service_locator.h"
 #include "../../services/tiles_manager.h"
 
-DecorationMenuGraphicsComponent::DecorationMenuGraphicsComponent(): GraphicsComponent() {}
+DecorationMenuGraphicsComponent::DecorationMenuGraphicsComponent():
+  GraphicsComponent(),
+  panel { },
+  renderedVersion { -1 }
+{}
 
 void DecorationMenuGraphicsComponent::Render(GameObject& menu, RenderSystem& renderer) {
   DecorationMenu *decorationMenu = dynamic_cast<DecorationMenu*>(&menu);
   if (!decorationMenu) throw GameError("Incorrect object type provided!");
 
+  const Rectangle2D& bounds = decorationMenu->Position;
+  int width = static_cast<int>(bounds.width);
+  int height = static_cast<int>(bounds.height);
+  if (!panel.IsValid() || renderer.GetTextureWidth(panel) != width || renderer.GetTextureHeight(panel) != height) {
+    if (panel.IsValid()) renderer.UnloadTexture(panel);
+    panel = renderer.LoadRenderTexture(width, height);
+    renderedVersion = -1;
+  }
+
+  if (renderedVersion != decorationMenu->Version()) {
+    renderer.BeginTextureMode(panel);
+    renderer.ClearBackground(Color2D::Blank());
+    renderPanel(*decorationMenu, renderer, { -bounds.x, -bounds.y });
+    renderer.EndTextureMode();
+    renderedVersion = decorationMenu->Version();
+  }
+
+  renderer.SetLayer(RenderLayer::UiBackground);
+  renderer.DrawTexture(panel, { bounds.x, bounds.y }, Color2D::White());
+}
+
+// Draws in panel coordinates: offset moves screen-space menu rects into the render texture
+void DecorationMenuGraphicsComponent::renderPanel(const DecorationMenu& decorationMenu, RenderSystem& renderer, Position2D offset) {
   const Color2D menuBackground = Color2D::MenuBackground();
   const Color2D rowBackground = Color2D::MenuRowBackground();
   const Color2D rowSelected = Color2D::MenuRowSelected();
   const Color2D rowHoverBorder = Color2D::MenuRowHoverBorder();
   const Color2D textColor = Color2D::MenuText();
 
-  renderer.DrawRectangle(decorationMenu->Position, menuBackground);
+  renderer.SetLayer(RenderLayer::UiBackground);
+  const Rectangle2D& bounds = decorationMenu.Position;
+  renderer.DrawRectangle({ bounds.x + offset.x, bounds.y + offset.y, bounds.width, bounds.height }, menuBackground);
 
-  const auto& items = decorationMenu->Items();
-  const int itemCount = static_cast<int>(items.size());
+  const auto& items = decorationMenu.Items();
   TilesManager& tilesManager = ServiceLocator::GetTilesManager();
   const auto& tileTypes = tilesManager.TileTypes();
 
-  for (int i = 0; i < itemCount; ++i) {
-    Rectangle2D rowRect = decorationMenu->ItemRect(i);
-    bool isSelected = (i == decorationMenu->SelectedIndex());
-    bool isHovered = (i == decorationMenu->HoveredIndex());
+  // Rows cut by the panel edge are clipped by the render texture
+  auto [first, last] = decorationMenu.VisibleItemRange();
+  for (int i = first; i < last; ++i) {
+    Rectangle2D rowRect = decorationMenu.ItemRect(i);
+    rowRect.x += offset.x;
+    rowRect.y += offset.y;
+    bool isSelected = (i == decorationMenu.SelectedIndex());
+    bool isHovered = (i == decorationMenu.HoveredIndex());
     float border = 1.0f;
 
+    renderer.SetLayer(RenderLayer::UiRows);
     if (isHovered) {
       renderer.DrawRectangle(rowRect, rowHoverBorder);
     }
@@ -55,28 +88,37 @@ void DecorationMenuGraphicsComponent::Render(GameObject& menu, RenderSystem& ren
       continue;
     }
 
+    // Thumbnails come from the atlas, which stays on the GPU whatever the terrain residency
     const WorldTileTerrainType& tileType = it->second;
-    ImageHandle imgHandle = tileType.TextureImage();
-    int imgW = renderer.GetImageWidth(imgHandle);
-    int imgH = renderer.GetImageHeight(imgHandle);
+    Rectangle2D atlasRect = tileType.AtlasRect();
+    float imgW = atlasRect.width;
+    float imgH = atlasRect.height;
     float imgX = rowRect.x + 6.0f;
-    float imgY = rowRect.y + (rowRect.height - static_cast<float>(imgH)) * 0.5f;
     float maxThumbSize = rowRect.height - 12.0f;
-    float maxDim = static_cast<float>(std::max(imgW, imgH));
+    float maxDim = std::max(imgW, imgH);
     float scale = maxDim > 0.0f ? (maxThumbSize / maxDim) : 1.0f;
     if (scale > 1.0f) {
       scale = 1.0f;
     }
-    float scaledW = static_cast<float>(imgW) * scale;
-    float scaledH = static_cast<float>(imgH) * scale;
-    imgY = rowRect.y + (rowRect.height - scaledH) * 0.5f;
-    renderer.DrawTexture(tileType.Texture(), { imgX, imgY }, Color2D::White(), scale);
+    float scaledW = imgW * scale;
+    float scaledH = imgH * scale;
+    float imgY = rowRect.y + (rowRect.height - scaledH) * 0.5f;
+    renderer.SetLayer(RenderLayer::UiIcons);
+    renderer.DrawTexturePro(tilesManager.Atlas(), atlasRect, { imgX, imgY, scaledW, scaledH }, Color2D::White());
 
     float textX = imgX + scaledW + 10.0f;
     int fontSize = 16;
     float textY = rowRect.y + (rowRect.height - fontSize) * 0.5f;
+    renderer.SetLayer(RenderLayer::UiText);
     renderer.DrawText(items[i].c_str(), { textX, textY }, fontSize, textColor);
   }
 }
 
+void DecorationMenuGraphicsComponent::Unload(RenderSystem& renderer) {
+  if (panel.IsValid()) {
+    renderer.UnloadTexture(panel);
+    panel = TextureHandle();
+  }
+}
+
 DecorationMenuGraphicsComponent::~DecorationMenuGraphicsComponent() {}
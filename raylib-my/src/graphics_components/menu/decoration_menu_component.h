@@ -1,15 +1,25 @@
 #pragma once
 
 #include "../component.h"
+#include "../../common/position_2d.h"
+#include "../../common/texture_handle.h"
 
 // Forward declarations
 class GameObject;
 class RenderSystem;
 class DecorationMenu;
 
+// Keeps the panel in a render texture, redrawn only when the menu version changes
 class DecorationMenuGraphicsComponent: public GraphicsComponent {
 public:
   DecorationMenuGraphicsComponent();
   virtual void Render(GameObject&, RenderSystem&) override;
+  virtual void Unload(RenderSystem&) override;
   ~DecorationMenuGraphicsComponent() override;
+
+private:
+  TextureHandle panel;
+  int renderedVersion;
+
+  void renderPanel(const DecorationMenu&, RenderSystem&, Position2D offset);
 };
@@ -0,0 +1,205 @@
+#include "minimap_component.h"
+
+#include <algorithm>
+#include <vector>
+
+#include "../../graphics/render_system.h"
+#include "../../menus/minimap.h"
+#include "../../game_world.h"
+#include "../../common/game_error.h"
+#include "../../common/color_2d.h"
+#include "../../common/grph_camera.h"
+#include "../../common/iso_projection.h"
+#include "../../config/game_config.h"
+#include "../../services/service_locator.h"
+
+namespace {
+
+// Liang-Barsky; returns false when the segment lies fully outside the rect
+bool clipSegment(Position2D& start, Position2D& end, const Rectangle2D& rect) {
+  float dx = end.x - start.x;
+  float dy = end.y - start.y;
+  const float p[] = { -dx, dx, -dy, dy };
+  const float q[] = {
+    start.x - rect.x,
+    rect.x + rect.width - start.x,
+    start.y - rect.y,
+    rect.y + rect.height - start.y
+  };
+
+  float t0 = 0.0f;
+  float t1 = 1.0f;
+  for (int i = 0; i < 4; ++i) {
+    if (p[i] == 0.0f) {
+      if (q[i] < 0.0f) return false;
+      continue;
+    }
+    float t = q[i] / p[i];
+    if (p[i] < 0.0f) {
+      t0 = std::max(t0, t);
+    } else {
+      t1 = std::min(t1, t);
+    }
+    if (t0 > t1) return false;
+  }
+
+  Position2D clippedStart { start.x + t0 * dx, start.y + t0 * dy };
+  end = { start.x + t1 * dx, start.y + t1 * dy };
+  start = clippedStart;
+  return true;
+}
+
+}
+
+MinimapGraphicsComponent::MinimapGraphicsComponent():
+  GraphicsComponent(),
+  image { },
+  texture { },
+  dirtyConsumer { -1 },
+  tilesPerPixel { 1 },
+  imageWidth { 0 },
+  imageHeight { 0 },
+  paintedChunks { }
+{}
+
+void MinimapGraphicsComponent::Render(GameObject& obj, RenderSystem& renderer) {
+  Minimap *minimap = dynamic_cast<Minimap*>(&obj);
+  if (!minimap) throw GameError("Incorrect object type provided!");
+
+  refresh(*minimap, renderer);
+
+  renderer.SetLayer(RenderLayer::UiBackground);
+  renderer.DrawRectangle(minimap->Position, Color2D::MenuBackground());
+
+  renderer.SetLayer(RenderLayer::UiIcons);
+  renderer.DrawTexturePro(texture, { 0.0f, 0.0f, float(imageWidth), float(imageHeight) },
+                          minimap->MapRect(), Color2D::White());
+
+  renderViewport(*minimap, renderer);
+}
+
+void MinimapGraphicsComponent::refresh(Minimap& minimap, RenderSystem& renderer) {
+  GameWorld& world = minimap.World();
+  if (dirtyConsumer < 0) {
+    // A new consumer starts with every tile dirty, which gives the initial fill
+    dirtyConsumer = world.RegisterDirtyConsumer(chunkSize);
+    while (std::max(world.MapWidth, world.MapHeight) > maxImageSide * tilesPerPixel) {
+      tilesPerPixel *= 2;
+    }
+    imageWidth = (world.MapWidth + tilesPerPixel - 1) / tilesPerPixel;
+    imageHeight = (world.MapHeight + tilesPerPixel - 1) / tilesPerPixel;
+    image = renderer.GenImageColor(float(imageWidth), float(imageHeight), Color2D::Blank());
+  }
+
+  TileDirtySet& dirty = world.DirtyTiles(dirtyConsumer);
+  bool paged = world.Tiles().IsPaged();
+  auto paint = [&](int x, int y) { paintTile(world, renderer, x, y); };
+
+  if (!texture.IsValid()) {
+    if (paged) {
+      // Reading every tile would page the whole map through memory
+      dirty.Clear();
+    } else {
+      dirty.DrainAll(paint);
+    }
+    texture = renderer.LoadTextureFromImage(image);
+  }
+
+  if (paged) paintExplored(world, renderer);
+  if (dirty.IsEmpty()) return;
+
+  // Draining empties the chunk list, so work from a copy
+  std::vector<int> chunks = dirty.DirtyChunks();
+  int chunksPerRow = (world.MapWidth + chunkSize - 1) / chunkSize;
+  for (int chunk : chunks) {
+    dirty.DrainChunk(chunk, paint);
+
+    int x0 = (chunk % chunksPerRow) * chunkSize;
+    int y0 = (chunk / chunksPerRow) * chunkSize;
+    TileRange tiles { x0, y0, std::min(x0 + chunkSize, world.MapWidth), std::min(y0 + chunkSize, world.MapHeight) };
+    Rectangle2D region = pixelRegion(tiles);
+    if (region.width > 0.0f && region.height > 0.0f) {
+      renderer.UpdateTextureRegion(texture, image, region);
+    }
+  }
+}
+
+// Downsampled maps show the top-left tile of each square
+void MinimapGraphicsComponent::paintTile(GameWorld& world, RenderSystem& renderer, int x, int y) {
+  if (x % tilesPerPixel != 0 || y % tilesPerPixel != 0) return;
+  renderer.ImageDrawPixel(image, x / tilesPerPixel, y / tilesPerPixel,
+                          world.GetTile(y * world.MapWidth + x).MinimapColor());
+}
+
+// Chunks stay painted after eviction; only their edits wait until they are paged back in
+void MinimapGraphicsComponent::paintExplored(GameWorld& world, RenderSystem& renderer) {
+  const WorldTileStorage& tiles = world.Tiles();
+  if (paintedChunks.empty()) {
+    paintedChunks.assign(tiles.ChunkCount(), 0);
+  }
+
+  for (int chunk : tiles.ResidentChunks()) {
+    if (paintedChunks[chunk]) continue;
+    paintedChunks[chunk] = 1;
+
+    TileRange range = tiles.ChunkTiles(chunk);
+    int startX = (range.minX + tilesPerPixel - 1) / tilesPerPixel * tilesPerPixel;
+    int startY = (range.minY + tilesPerPixel - 1) / tilesPerPixel * tilesPerPixel;
+    for (int y = startY; y < range.maxY; y += tilesPerPixel) {
+      for (int x = startX; x < range.maxX; x += tilesPerPixel) {
+        paintTile(world, renderer, x, y);
+      }
+    }
+    Rectangle2D region = pixelRegion(range);
+    if (region.width > 0.0f && region.height > 0.0f) {
+      renderer.UpdateTextureRegion(texture, image, region);
+    }
+  }
+}
+
+// Pixels whose sampled tile falls inside the range
+Rectangle2D MinimapGraphicsComponent::pixelRegion(const TileRange& tiles) const {
+  int x0 = (tiles.minX + tilesPerPixel - 1) / tilesPerPixel;
+  int y0 = (tiles.minY + tilesPerPixel - 1) / tilesPerPixel;
+  int x1 = (tiles.maxX + tilesPerPixel - 1) / tilesPerPixel;
+  int y1 = (tiles.maxY + tilesPerPixel - 1) / tilesPerPixel;
+  return { float(x0), float(y0), float(std::max(0, x1 - x0)), float(std::max(0, y1 - y0)) };
+}
+
+// The screen is a rectangle in world space, so in grid space it is a rhombus
+void MinimapGraphicsComponent::renderViewport(const Minimap& minimap, RenderSystem& renderer) {
+  const GameConfig& config = ServiceLocator::GetConfig();
+  GameCamera& camera = minimap.World().GetCamera();
+  GrphCamera view(camera.offset, camera.target, camera.rotation, camera.zoom);
+  IsoProjection projection(config.TileWidth, config.TileHeight);
+
+  float w = float(config.ScreenWidth);
+  float h = float(config.ScreenHeight);
+  const Position2D screenCorners[] = { { 0.0f, 0.0f }, { w, 0.0f }, { w, h }, { 0.0f, h } };
+  auto toMinimap = [&](Position2D screen) {
+    return minimap.GridToMinimap(projection.WorldToGrid(view.ScreenToWorld(screen)));
+  };
+
+  Rectangle2D mapRect = minimap.MapRect();
+  renderer.SetLayer(RenderLayer::UiText);
+  for (int i = 0; i < 4; ++i) {
+    Position2D start = toMinimap(screenCorners[i]);
+    Position2D end = toMinimap(screenCorners[(i + 1) % 4]);
+    if (clipSegment(start, end, mapRect)) {
+      renderer.DrawLine(start, end, Color2D::White(), 1.0f);
+    }
+  }
+}
+
+void MinimapGraphicsComponent::Unload(RenderSystem& renderer) {
+  if (texture.IsValid()) {
+    renderer.UnloadTexture(texture);
+    texture = TextureHandle();
+  }
+  if (image.IsValid()) {
+    renderer.UnloadImage(image);
+    image = ImageHandle();
+  }
+}
+
+MinimapGraphicsComponent::~MinimapGraphicsComponent() {}
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "../component.h"
+#include "../../common/image_handle.h"
+#include "../../common/position_2d.h"
+#include "../../common/rectangle_2d.h"
+#include "../../common/texture_handle.h"
+#include "../../common/tile_range.h"
+
+// Forward declarations
+class GameObject;
+class RenderSystem;
+class Minimap;
+class GameWorld;
+
+// Keeps a CPU image with one pixel per tile and re-uploads only the chunks the
+// world reports as dirty, so a steady-state frame touches no pixels at all.
+// Maps wider than maxImageSide sample one tile per square of tilesPerPixel.
+// A paged world is never read in full: chunks are painted as they first become
+// resident, so the minimap shows the explored part of the map.
+class MinimapGraphicsComponent: public GraphicsComponent {
+public:
+  MinimapGraphicsComponent();
+  virtual void Render(GameObject&, RenderSystem&) override;
+  virtual void Unload(RenderSystem&) override;
+  ~MinimapGraphicsComponent() override;
+
+private:
+  static constexpr int chunkSize = 32;
+  static constexpr int maxImageSide = 2048;
+  ImageHandle image;
+  TextureHandle texture;
+  int dirtyConsumer;
+  int tilesPerPixel;
+  int imageWidth;
+  int imageHeight;
+  std::vector<uint8_t> paintedChunks;
+
+  void refresh(Minimap&, RenderSystem&);
+  void paintTile(GameWorld&, RenderSystem&, int x, int y);
+  void paintExplored(GameWorld&, RenderSystem&);
+  Rectangle2D pixelRegion(const TileRange&) const;
+  void renderViewport(const Minimap&, RenderSystem&);
+};
@@ -1,13 +1,16 @@
 #pragma once
 
-#include "component.h"
-
 // Forward declaration
-class WorldTile;
+class WorldTileView;
+class RenderSystem;
+class ImageHandle;
+class Position2D;
 
-class TileGraphicsComponent: public GraphicsComponent {
+// Tiles are plain rows in the world's column storage rather than game objects,
+// so their drawing is a free helper the world renderers call directly
+class TileGraphicsComponent {
 public:
-  TileGraphicsComponent();
-  virtual void Render(GameObject&, RenderSystem&) override;
-  ~TileGraphicsComponent() override;
+  // Draws into an explicit image instead of the renderer's Dst, so tiles of
+  // different images can be rasterized from several threads at once
+  static void Rasterize(const WorldTileView&, RenderSystem&, ImageHandle dst, Position2D correction);
 };
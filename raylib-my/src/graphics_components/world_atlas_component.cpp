@@ -0,0 +1,29 @@
+#include "world_atlas_component.h"
+
+#include "../common/color_2d.h"
+#include "../common/rectangle_2d.h"
+#include "../game_world.h"
+#include "../graphics/render_system.h"
+#include "../services/service_locator.h"
+#include "../services/tiles_manager.h"
+#include "../world_tiles/tile_view.h"
+
+WorldAtlasGraphicsComponent::WorldAtlasGraphicsComponent(): WorldGraphicsComponent() {}
+
+void WorldAtlasGraphicsComponent::initializeTerrain(GameWorld&, RenderSystem&) {
+  // Atlas is owned by TilesManager and built at LoadTextures time
+}
+
+void WorldAtlasGraphicsComponent::renderTerrain(GameWorld& world, RenderSystem& renderer) {
+  TextureHandle atlas = ServiceLocator::GetTilesManager().Atlas();
+  float tileWidth = renderer.GetTileWidth();
+  float tileHeight = renderer.GetTileHeight();
+
+  world.ForEachVisibleTile([&](const WorldTileView& tile) {
+    Position2D center = renderer.GridToScreen(tile.Pos());
+    Rectangle2D dst { center.x - tileWidth * 0.5f, center.y - tileHeight * 0.5f, tileWidth, tileHeight };
+    renderer.DrawTexturePro(atlas, tile.AtlasRect(), dst, Color2D::White());
+  });
+}
+
+WorldAtlasGraphicsComponent::~WorldAtlasGraphicsComponent() {}
@@ -0,0 +1,18 @@
+#pragma once
+
+#include "./world_component.h"
+
+// Forward declarations
+class RenderSystem;
+class GameWorld;
+
+// Draws visible tiles as textured quads sampled from the terrain atlas, without CPU rasterization
+class WorldAtlasGraphicsComponent: public WorldGraphicsComponent {
+public:
+  WorldAtlasGraphicsComponent();
+  ~WorldAtlasGraphicsComponent() override;
+
+protected:
+  void initializeTerrain(GameWorld&, RenderSystem&) override;
+  void renderTerrain(GameWorld&, RenderSystem&) override;
+};
@@ -0,0 +1,136 @@
+#include "world_chunk.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "../common/color_2d.h"
+#include "../graphics/render_system.h"
+
+WorldChunk::WorldChunk(TileRange range, int lodLevels):
+  tiles { range },
+  origin { 0.0f, 0.0f },
+  width { 0.0f },
+  height { 0.0f },
+  levels(std::max(1, lodLevels)),
+  dirty { false },
+  dirtyRect { 0, 0, 0, 0 }
+{}
+
+void WorldChunk::Allocate(RenderSystem& renderer) {
+  float tileWidth = renderer.GetTileWidth();
+  float tileHeight = renderer.GetTileHeight();
+  int tilesAcross = (tiles.maxX - tiles.minX) + (tiles.maxY - tiles.minY);
+
+  // Bounding box of the chunk diamond: leftmost point is the left corner of tile
+  // (minX, maxY - 1), topmost point the top corner of tile (minX, minY), half a
+  // tile above its centre
+  origin = Position2D(0.5f * tileWidth * (tiles.minX - tiles.maxY),
+                      0.5f * tileHeight * (tiles.minX + tiles.minY) - 0.5f * tileHeight);
+  width = 0.5f * tileWidth * tilesAcross;
+  height = 0.5f * tileHeight * tilesAcross;
+
+  EnsureImages(renderer);
+}
+
+void WorldChunk::Release(RenderSystem& renderer) {
+  for (Level& level : levels) {
+    if (level.texture.IsValid()) {
+      renderer.UnloadTexture(level.texture);
+      level.texture = TextureHandle();
+    }
+  }
+  ReleaseImages(renderer);
+}
+
+bool WorldChunk::HasImages() const {
+  return levels[0].image.IsValid();
+}
+
+bool WorldChunk::EnsureImages(RenderSystem& renderer) {
+  if (HasImages()) return false;
+
+  for (size_t i = 0; i < levels.size(); ++i) {
+    float divisor = static_cast<float>(1 << i);
+    levels[i].image = renderer.GenImageColor(std::ceil(width / divisor), std::ceil(height / divisor), Color2D(0, 0, 0, 0));
+  }
+  return true;
+}
+
+void WorldChunk::ReleaseImages(RenderSystem& renderer) {
+  for (Level& level : levels) {
+    if (level.image.IsValid()) {
+      renderer.UnloadImage(level.image);
+      level.image = ImageHandle();
+    }
+  }
+}
+
+Rectangle2D WorldChunk::levelRegion(int lodLevel) const {
+  float divisor = static_cast<float>(1 << lodLevel);
+  float minX = std::floor(dirtyRect.x / divisor);
+  float minY = std::floor(dirtyRect.y / divisor);
+  float maxX = std::ceil((dirtyRect.x + dirtyRect.width) / divisor);
+  float maxY = std::ceil((dirtyRect.y + dirtyRect.height) / divisor);
+  return { minX, minY, maxX - minX, maxY - minY };
+}
+
+void WorldChunk::Upload(RenderSystem& renderer) {
+  for (size_t i = 0; i < levels.size(); ++i) {
+    Level& level = levels[i];
+    Rectangle2D region = levelRegion(static_cast<int>(i));
+    if (i > 0) {
+      renderer.ImageDownsample(levels[i - 1].image, level.image, region);
+    }
+
+    if (level.texture.IsValid()) {
+      renderer.UpdateTextureRegion(level.texture, level.image, region);
+    } else {
+      level.texture = renderer.LoadTextureFromImage(level.image);
+    }
+  }
+  dirty = false;
+}
+
+void WorldChunk::Draw(RenderSystem& renderer, int lodLevel) const {
+  int index = std::clamp(lodLevel, 0, static_cast<int>(levels.size()) - 1);
+  renderer.DrawTexture(levels[index].texture, origin, Color2D::White(), static_cast<float>(1 << index));
+}
+
+void WorldChunk::MarkTileDirty(RenderSystem& renderer, Position2D tilePos) {
+  Position2D center = renderer.GridToScreen(tilePos);
+  center += Correction();
+
+  // One extra pixel around the diamond covers the frame line thickness
+  float halfWidth = renderer.GetTileWidth() * 0.5f + 1.0f;
+  float halfHeight = renderer.GetTileHeight() * 0.5f + 1.0f;
+  float minX = std::max(0.0f, std::floor(center.x - halfWidth));
+  float minY = std::max(0.0f, std::floor(center.y - halfHeight));
+  float maxX = std::min(width, std::ceil(center.x + halfWidth));
+  float maxY = std::min(height, std::ceil(center.y + halfHeight));
+
+  if (dirty) {
+    minX = std::min(minX, dirtyRect.x);
+    minY = std::min(minY, dirtyRect.y);
+    maxX = std::max(maxX, dirtyRect.x + dirtyRect.width);
+    maxY = std::max(maxY, dirtyRect.y + dirtyRect.height);
+  }
+
+  dirtyRect = { minX, minY, maxX - minX, maxY - minY };
+  dirty = true;
+}
+
+bool WorldChunk::IsDirty() const {
+  return dirty;
+}
+
+const TileRange& WorldChunk::Tiles() const {
+  return tiles;
+}
+
+ImageHandle WorldChunk::Image() const {
+  return levels[0].image;
+}
+
+Position2D WorldChunk::Correction() const {
+  return Position2D(-origin.x, -origin.y);
+}
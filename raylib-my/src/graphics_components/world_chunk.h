@@ -0,0 +1,50 @@
+#pragma once
+
+#include <vector>
+
+#include "../common/image_handle.h"
+#include "../common/position_2d.h"
+#include "../common/rectangle_2d.h"
+#include "../common/texture_handle.h"
+#include "../common/tile_range.h"
+
+// Forward declaration
+class RenderSystem;
+
+class WorldChunk {
+public:
+  WorldChunk(TileRange, int lodLevels);
+
+  void Allocate(RenderSystem&);
+  void Release(RenderSystem&);
+  // CPU side of the pyramid; once released, the chunk keeps drawing from its textures
+  // and EnsureImages hands back blank images that must be fully re-rasterized
+  bool HasImages() const;
+  bool EnsureImages(RenderSystem&);
+  void ReleaseImages(RenderSystem&);
+  void Upload(RenderSystem&);
+  void Draw(RenderSystem&, int lodLevel) const;
+
+  void MarkTileDirty(RenderSystem&, Position2D tilePos);
+  bool IsDirty() const;
+  const TileRange& Tiles() const;
+  ImageHandle Image() const;
+  Position2D Correction() const;
+
+private:
+  // Level 0 is full resolution, every next level is downsampled by two
+  struct Level {
+    ImageHandle image;
+    TextureHandle texture;
+  };
+
+  Rectangle2D levelRegion(int lodLevel) const;
+
+  TileRange tiles;
+  Position2D origin;
+  float width;
+  float height;
+  std::vector<Level> levels;
+  bool dirty;
+  Rectangle2D dirtyRect;
+};
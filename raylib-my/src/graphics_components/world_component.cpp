@@ -4,7 +4,9 @@
 #include "../common/game_error.h"
 #include "../game_world.h"
 #include "../graphics/render_system.h"
-#include "../world_tiles/tile.h"
+#include "../services/service_locator.h"
+#include "../services/tiles_manager.h"
+#include "../world_tiles/tile_view.h"
 
 WorldGraphicsComponent::WorldGraphicsComponent():
   GraphicsComponent(),
@@ -17,24 +19,58 @@ void WorldGraphicsComponent::drawIsoTileFrame(RenderSystem& renderer, Position2D
   renderer.DrawDiamondFrame(center, Color2D::Magenta(), false, 1.5f);  // MAGENTA
 }
 
+// GridToScreen maps a tile to its centre, so tile edges lie half a tile off the
+// integer grid coordinates. The whole visible grid is one straight line per grid
+// row and column instead of four lines per tile.
+void WorldGraphicsComponent::drawGrid(GameWorld& world, RenderSystem& renderer) {
+  const TileRange& range = world.VisibleRange();
+  if (range.IsEmpty()) return;
+
+  Color2D color = world.GridColor();
+  float minX = range.minX - 0.5f;
+  float minY = range.minY - 0.5f;
+  float maxX = range.maxX - 0.5f;
+  float maxY = range.maxY - 0.5f;
+  for (int x = range.minX; x <= range.maxX; ++x) {
+    float edge = x - 0.5f;
+    renderer.DrawLine(renderer.GridToScreen({ edge, minY }), renderer.GridToScreen({ edge, maxY }), color, 1.0f);
+  }
+  for (int y = range.minY; y <= range.maxY; ++y) {
+    float edge = y - 0.5f;
+    renderer.DrawLine(renderer.GridToScreen({ minX, edge }), renderer.GridToScreen({ maxX, edge }), color, 1.0f);
+  }
+}
+
+void WorldGraphicsComponent::drawOverlays(GameWorld& world, RenderSystem& renderer) {
+  const TilesManager& tilesManager = ServiceLocator::GetTilesManager();
+  TextureHandle sheet = tilesManager.OverlaySheet();
+  float tileWidth = renderer.GetTileWidth();
+  float tileHeight = renderer.GetTileHeight();
+
+  world.ForEachVisibleOverlayTile([&](const WorldTileView& tile) {
+    Position2D center = renderer.GridToScreen(tile.Pos());
+    Rectangle2D dst { center.x - tileWidth * 0.5f, center.y - tileHeight * 0.5f, tileWidth, tileHeight };
+    if (tile.HasDecoration()) {
+      renderer.DrawTexturePro(sheet, tilesManager.DecorationSprite(tile.Decoration()), dst, Color2D::White());
+    }
+    if (tile.HasResource()) {
+      renderer.DrawTexturePro(sheet, tilesManager.ResourceSprite(tile.Resource()), dst, Color2D::White());
+    }
+  });
+}
+
 void WorldGraphicsComponent::Render(GameObject& wld, RenderSystem& renderer) {
   GameWorld* world = dynamic_cast<GameWorld*>(&wld);
   if (!world) throw GameError("Incorrect object type provided!");
 
   if (!initialized) {
     world->GetCamera().UpdateFromGrphCamera(renderer.GetGrphCamera());
-
-    float tileWidth = renderer.GetTileWidth();
-    float tileHeight = renderer.GetTileHeight();
-    float width =  0.5 * tileWidth * (world->MapWidth + world->MapHeight);
-    float height = 0.5 * tileHeight * (world->MapWidth + world->MapHeight);
-
-    worldTileMap = renderer.GenImageColor(width, height, Color2D(0, 0, 0, 0));
-
+    initializeTerrain(*world, renderer);
     initialized = true;
   }
 
   world->GetCamera().Render(renderer);
+  world->SetVisibleRange(renderer.VisibleTileRange(world->MapWidth, world->MapHeight));
 
   Position2D gridF = renderer.MouseToWorld2D();
   gridF += { 0.5f, 0.5f };
@@ -42,30 +78,18 @@ void WorldGraphicsComponent::Render(GameObject& wld, RenderSystem& renderer) {
   renderer.ClearBackground(Color2D(245, 245, 245, 255));  // RAYWHITE
 
   renderer.BeginMode2D();
-    bool redraw = false;
-    float tileWidth = renderer.GetTileWidth();
-    renderer.SetDst(worldTileMap);
-    renderer.SetCorrection(Position2D(world->MapHeight * tileWidth / 2.0f, 0.0f));
-
-    for(int i = 0; i < world->MapHeight * world->MapWidth; ++i) {
-      WorldTile& tile = world->GetTile(i);
-      if (tile.Dirty) {
-        tile.Render(renderer);
-        redraw |= true;
-      }
+    renderer.SetLayer(RenderLayer::Terrain);
+    renderTerrain(*world, renderer);
+    if (world->GridVisible()) {
+      renderer.SetLayer(RenderLayer::TerrainOverlay);
+      drawGrid(*world, renderer);
     }
-
-    if (redraw) {
-      if (mapTexture.IsValid()) {
-        renderer.UnloadTexture(mapTexture);
-      }
-      mapTexture = renderer.LoadTextureFromImage(worldTileMap);
-    }
-
-  Position2D correction = renderer.GetCorrection();
-  renderer.DrawTexture(mapTexture, Position2D(-correction.x, -correction.y), Color2D(255, 255, 255, 255));  // WHITE
-  drawIsoTileFrame(renderer, gridF);
+    renderer.SetLayer(RenderLayer::Decorations);
+    drawOverlays(*world, renderer);
+    renderer.SetLayer(RenderLayer::Cursor);
+    drawIsoTileFrame(renderer, gridF);
   renderer.EndMode2D();
+  renderer.SetLayer(RenderLayer::Debug);
   renderer.DrawFPS(10, 10);
 }
 
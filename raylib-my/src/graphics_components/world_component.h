@@ -1,8 +1,6 @@
 #pragma once
 
 #include "./component.h"
-#include "../common/image_handle.h"
-#include "../common/texture_handle.h"
 
 // Forward declarations
 class GameObject;
@@ -16,9 +14,13 @@ public:
   virtual void Render(GameObject&, RenderSystem&) override;
   ~WorldGraphicsComponent() override;
 
+protected:
+  virtual void initializeTerrain(GameWorld&, RenderSystem&) = 0;
+  virtual void renderTerrain(GameWorld&, RenderSystem&) = 0;
+
 private:
   void drawIsoTileFrame(RenderSystem&, Position2D);
-  ImageHandle worldTileMap;
-  TextureHandle mapTexture;
+  void drawGrid(GameWorld&, RenderSystem&);
+  void drawOverlays(GameWorld&, RenderSystem&);
   bool initialized;
 };
@@ -0,0 +1,127 @@
+#include "world_image_component.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+#include "tile_component.h"
+#include "../common/worker_pool.h"
+#include "../game_world.h"
+#include "../graphics/render_system.h"
+#include "../services/service_locator.h"
+#include "../world_tiles/tile_view.h"
+
+WorldImageGraphicsComponent::WorldImageGraphicsComponent(int levels, bool keepImages):
+  WorldGraphicsComponent(),
+  chunks { },
+  chunksPerRow { 0 },
+  lodLevels { std::max(1, levels) },
+  keepChunkImages { keepImages },
+  dirtyConsumer { -1 },
+  startupReported { false }
+{}
+
+void WorldImageGraphicsComponent::initializeTerrain(GameWorld& world, RenderSystem& renderer) {
+  chunksPerRow = (world.MapWidth + chunkSize - 1) / chunkSize;
+  int chunkRows = (world.MapHeight + chunkSize - 1) / chunkSize;
+
+  chunks.clear();
+  chunks.reserve(chunksPerRow * chunkRows);
+  for (int cy = 0; cy < chunkRows; ++cy) {
+    for (int cx = 0; cx < chunksPerRow; ++cx) {
+      int minX = cx * chunkSize;
+      int minY = cy * chunkSize;
+      chunks.emplace_back(TileRange(minX, minY, std::min(minX + chunkSize, world.MapWidth), std::min(minY + chunkSize, world.MapHeight)), lodLevels);
+      chunks.back().Allocate(renderer);
+    }
+  }
+  pendingTiles.assign(chunks.size(), {});
+  dirtyConsumer = world.RegisterDirtyConsumer(chunkSize);
+}
+
+int WorldImageGraphicsComponent::lodLevelForZoom(float zoom) const {
+  if (zoom >= 1.0f) return 0;
+  int level = static_cast<int>(std::floor(std::log2(1.0f / zoom)));
+  return std::clamp(level, 0, lodLevels - 1);
+}
+
+void WorldImageGraphicsComponent::rasterizeDirtyTiles(GameWorld& world, RenderSystem& renderer) {
+  TileDirtySet& dirty = world.DirtyTiles(dirtyConsumer);
+  if (dirty.IsEmpty()) return;
+
+  // Off-screen chunks stay dirty until they scroll into view
+  const TileRange& visible = world.VisibleRange();
+  for (int index : dirty.DirtyChunks()) {
+    if (chunks[index].Tiles().Intersects(visible)) pendingChunks.push_back(index);
+  }
+  if (pendingChunks.empty()) return;
+
+  int tileCount = 0;
+  for (int index : pendingChunks) {
+    dirty.DrainChunk(index, [this, &world, index](int x, int y) {
+      pendingTiles[index].push_back(y * world.MapWidth + x);
+    });
+
+    // A chunk that dropped its CPU images has nothing to patch, so it is redrawn whole
+    WorldChunk& chunk = chunks[index];
+    if (chunk.EnsureImages(renderer)) {
+      const TileRange& tiles = chunk.Tiles();
+      pendingTiles[index].clear();
+      for (int y = tiles.minY; y < tiles.maxY; ++y) {
+        for (int x = tiles.minX; x < tiles.maxX; ++x) {
+          pendingTiles[index].push_back(y * world.MapWidth + x);
+        }
+      }
+    }
+    tileCount += static_cast<int>(pendingTiles[index].size());
+  }
+
+  auto start = std::chrono::steady_clock::now();
+
+  // One task per chunk: chunks own separate images, so tasks never touch the same
+  // pixels. Neighbouring diamonds share edge pixels only within a chunk, and those
+  // keep the serial draw order, so the result matches a single-threaded pass.
+  WorkerPool& pool = ServiceLocator::GetWorkerPool();
+  pool.ParallelFor(static_cast<int>(pendingChunks.size()), [this, &world, &renderer](int task) {
+    int index = pendingChunks[task];
+    WorldChunk& chunk = chunks[index];
+    for (int tileIndex : pendingTiles[index]) {
+      WorldTileView tile = world.GetTile(tileIndex);
+      TileGraphicsComponent::Rasterize(tile, renderer, chunk.Image(), chunk.Correction());
+      chunk.MarkTileDirty(renderer, tile.Pos());
+    }
+  });
+
+  for (int index : pendingChunks) pendingTiles[index].clear();
+  pendingChunks.clear();
+
+  if (!startupReported) {
+    startupReported = true;
+    TerrainRasterStats stats;
+    stats.tiles = tileCount;
+    stats.rasterMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    stats.threads = pool.ThreadCount();
+    world.RecordRasterStats(stats);
+  }
+}
+
+void WorldImageGraphicsComponent::renderTerrain(GameWorld& world, RenderSystem& renderer) {
+  rasterizeDirtyTiles(world, renderer);
+
+  const TileRange& visible = world.VisibleRange();
+  int lodLevel = lodLevelForZoom(renderer.GetGrphCamera().zoom);
+  for (WorldChunk& chunk : chunks) {
+    if (!chunk.Tiles().Intersects(visible)) continue;
+    if (chunk.IsDirty()) {
+      chunk.Upload(renderer);
+      if (!keepChunkImages) chunk.ReleaseImages(renderer);
+    }
+    chunk.Draw(renderer, lodLevel);
+  }
+}
+
+void WorldImageGraphicsComponent::Unload(RenderSystem& renderer) {
+  for (WorldChunk& chunk : chunks) chunk.Release(renderer);
+}
+
+WorldImageGraphicsComponent::~WorldImageGraphicsComponent() {}
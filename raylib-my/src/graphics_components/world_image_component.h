@@ -0,0 +1,40 @@
+#pragma once
+
+#include <vector>
+
+#include "./world_component.h"
+#include "./world_chunk.h"
+
+// Forward declarations
+class RenderSystem;
+class GameWorld;
+
+// Rasterizes tiles on the CPU into per-chunk images and draws one texture per visible chunk.
+// Without keepChunkImages a chunk frees its images after upload and is fully
+// re-rasterized the next time one of its tiles changes.
+class WorldImageGraphicsComponent: public WorldGraphicsComponent {
+public:
+  WorldImageGraphicsComponent(int lodLevels, bool keepChunkImages);
+  void Unload(RenderSystem&) override;
+  ~WorldImageGraphicsComponent() override;
+
+protected:
+  void initializeTerrain(GameWorld&, RenderSystem&) override;
+  void renderTerrain(GameWorld&, RenderSystem&) override;
+
+private:
+  static constexpr int chunkSize = 32;
+
+  int lodLevelForZoom(float zoom) const;
+  void rasterizeDirtyTiles(GameWorld&, RenderSystem&);
+
+  std::vector<WorldChunk> chunks;
+  int chunksPerRow;
+  int lodLevels;
+  bool keepChunkImages;
+  // Per-chunk dirty tile indices, kept between frames to reuse their capacity
+  std::vector<std::vector<int>> pendingTiles;
+  std::vector<int> pendingChunks;
+  int dirtyConsumer;
+  bool startupReported;
+};
@@ -0,0 +1,106 @@
+#include "world_mesh_component.h"
+
+#include <algorithm>
+#include <cstdint>
+
+#include "../common/position_2d.h"
+#include "../common/rectangle_2d.h"
+#include "../game_world.h"
+#include "../graphics/render_system.h"
+#include "../services/service_locator.h"
+#include "../services/tiles_manager.h"
+#include "../world_tiles/tile_view.h"
+
+WorldMeshGraphicsComponent::WorldMeshGraphicsComponent():
+  WorldGraphicsComponent(),
+  chunks { },
+  chunksPerRow { 0 },
+  dirtyConsumer { -1 }
+{}
+
+void WorldMeshGraphicsComponent::initializeTerrain(GameWorld& world, RenderSystem&) {
+  chunksPerRow = (world.MapWidth + chunkSize - 1) / chunkSize;
+  int chunkRows = (world.MapHeight + chunkSize - 1) / chunkSize;
+
+  chunks.clear();
+  chunks.reserve(chunksPerRow * chunkRows);
+  for (int cy = 0; cy < chunkRows; ++cy) {
+    for (int cx = 0; cx < chunksPerRow; ++cx) {
+      int minX = cx * chunkSize;
+      int minY = cy * chunkSize;
+      TileRange tiles { minX, minY, std::min(minX + chunkSize, world.MapWidth), std::min(minY + chunkSize, world.MapHeight) };
+      chunks.push_back({ tiles, MeshHandle(), true });
+    }
+  }
+  dirtyConsumer = world.RegisterDirtyConsumer(chunkSize);
+}
+
+void WorldMeshGraphicsComponent::rebuildChunk(GameWorld& world, RenderSystem& renderer, MeshChunk& chunk) {
+  TextureHandle atlas = ServiceLocator::GetTilesManager().Atlas();
+  float atlasWidth = static_cast<float>(renderer.GetTextureWidth(atlas));
+  float atlasHeight = static_cast<float>(renderer.GetTextureHeight(atlas));
+  float halfWidth = renderer.GetTileWidth() * 0.5f;
+  float halfHeight = renderer.GetTileHeight() * 0.5f;
+
+  std::vector<Position2D> vertices;
+  std::vector<Position2D> texcoords;
+  std::vector<uint16_t> indices;
+  vertices.reserve(chunk.tiles.Count() * 4);
+  texcoords.reserve(chunk.tiles.Count() * 4);
+  indices.reserve(chunk.tiles.Count() * 6);
+
+  for (int y = chunk.tiles.minY; y < chunk.tiles.maxY; ++y) {
+    for (int x = chunk.tiles.minX; x < chunk.tiles.maxX; ++x) {
+      WorldTileView tile = world.GetTile(y * world.MapWidth + x);
+      Position2D center = renderer.GridToScreen(tile.Pos());
+      Rectangle2D src = tile.AtlasRect();
+      uint16_t base = static_cast<uint16_t>(vertices.size());
+
+      // Diamond corners: top, right, bottom, left; the sprite diamond touches the middle of each edge
+      vertices.push_back({ center.x, center.y - halfHeight });
+      vertices.push_back({ center.x + halfWidth, center.y });
+      vertices.push_back({ center.x, center.y + halfHeight });
+      vertices.push_back({ center.x - halfWidth, center.y });
+      texcoords.push_back({ (src.x + src.width * 0.5f) / atlasWidth, src.y / atlasHeight });
+      texcoords.push_back({ (src.x + src.width) / atlasWidth, (src.y + src.height * 0.5f) / atlasHeight });
+      texcoords.push_back({ (src.x + src.width * 0.5f) / atlasWidth, (src.y + src.height) / atlasHeight });
+      texcoords.push_back({ src.x / atlasWidth, (src.y + src.height * 0.5f) / atlasHeight });
+
+      indices.insert(indices.end(), { base, uint16_t(base + 1), uint16_t(base + 2), base, uint16_t(base + 2), uint16_t(base + 3) });
+    }
+  }
+
+  if (chunk.mesh.IsValid()) {
+    renderer.UnloadMesh(chunk.mesh);
+  }
+  chunk.mesh = renderer.LoadMesh(vertices, texcoords, indices);
+  chunk.dirty = false;
+}
+
+void WorldMeshGraphicsComponent::renderTerrain(GameWorld& world, RenderSystem& renderer) {
+  // Meshes are rebuilt a whole chunk at a time, so the dirty list is emptied every
+  // frame into per-chunk stale flags; off-screen chunks rebuild once they come into view
+  TileDirtySet& dirty = world.DirtyTiles(dirtyConsumer);
+  dirty.DrainChunks([this](int index) { chunks[index].dirty = true; });
+  const TileRange& visible = world.VisibleRange();
+
+  TextureHandle atlas = ServiceLocator::GetTilesManager().Atlas();
+  for (MeshChunk& chunk : chunks) {
+    if (!chunk.tiles.Intersects(visible)) continue;
+    if (chunk.dirty) {
+      rebuildChunk(world, renderer, chunk);
+    }
+    renderer.DrawMesh(chunk.mesh, atlas);
+  }
+}
+
+void WorldMeshGraphicsComponent::Unload(RenderSystem& renderer) {
+  for (MeshChunk& chunk : chunks) {
+    if (chunk.mesh.IsValid()) {
+      renderer.UnloadMesh(chunk.mesh);
+      chunk.mesh = MeshHandle();
+    }
+  }
+}
+
+WorldMeshGraphicsComponent::~WorldMeshGraphicsComponent() {}
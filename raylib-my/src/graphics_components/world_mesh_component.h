@@ -0,0 +1,38 @@
+#pragma once
+
+#include <vector>
+
+#include "./world_component.h"
+#include "../common/mesh_handle.h"
+#include "../common/tile_range.h"
+
+// Forward declarations
+class RenderSystem;
+class GameWorld;
+
+// Keeps one static atlas-textured mesh per chunk and issues one draw per visible chunk
+class WorldMeshGraphicsComponent: public WorldGraphicsComponent {
+public:
+  WorldMeshGraphicsComponent();
+  void Unload(RenderSystem&) override;
+  ~WorldMeshGraphicsComponent() override;
+
+protected:
+  void initializeTerrain(GameWorld&, RenderSystem&) override;
+  void renderTerrain(GameWorld&, RenderSystem&) override;
+
+private:
+  static constexpr int chunkSize = 32;
+
+  struct MeshChunk {
+    TileRange tiles;
+    MeshHandle mesh;
+    bool dirty;
+  };
+
+  void rebuildChunk(GameWorld&, RenderSystem&, MeshChunk&);
+
+  std::vector<MeshChunk> chunks;
+  int chunksPerRow;
+  int dirtyConsumer;
+};
@@ -0,0 +1,160 @@
+#include "headless_benchmark.h"
+
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+#include "config/game_config.h"
+#include "game_interface.h"
+#include "graphics/command_buffer_renderer.h"
+#include "graphics/headless_graphics.h"
+#include "services/service_locator.h"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double ElapsedMs(Clock::time_point start) {
+  return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+// Repeating 240-frame tour: pan, zoom out, pan, browse the menu, zoom in, click tiles.
+// Depends only on the frame number so every run replays the same input.
+std::vector<HeadlessInputFrame> BuildScript(const GameConfig& config, int frames) {
+  std::vector<HeadlessInputFrame> script(frames);
+  float worldWidth = config.ScreenWidth - 210.0f;
+
+  for (int i = 0; i < frames; ++i) {
+    HeadlessInputFrame& frame = script[i];
+    int phase = i % 240;
+    float t = (phase % 60) / 60.0f;
+    frame.mouse = { worldWidth * t, config.ScreenHeight * 0.5f };
+
+    if (phase < 60) {
+      frame.keysDown.push_back(Keyboard2D::KEY_D);
+    } else if (phase < 90) {
+      if (phase % 10 == 0) frame.wheel = -1.0f;
+    } else if (phase < 150) {
+      frame.keysDown.push_back(Keyboard2D::KEY_S);
+    } else if (phase < 180) {
+      frame.mouse = { config.ScreenWidth - 105.0f, config.ScreenHeight * (phase - 150) / 30.0f };
+      frame.leftClick = phase % 15 == 0;
+    } else if (phase < 210) {
+      if (phase % 10 == 0) frame.wheel = 1.0f;
+    } else {
+      frame.keysDown.push_back(Keyboard2D::KEY_A);
+      frame.keysDown.push_back(Keyboard2D::KEY_W);
+      frame.leftClick = phase % 10 == 0;
+    }
+  }
+  return script;
+}
+
+void PrintSeries(const char* name, std::vector<double> samples) {
+  if (samples.empty()) return;
+  std::sort(samples.begin(), samples.end());
+  double total = 0.0;
+  for (double sample : samples) total += sample;
+  auto percentile = [&samples](double p) {
+    return samples[std::min(samples.size() - 1, size_t(p * samples.size()))];
+  };
+
+  std::cout << std::left << std::setw(8) << name << std::right << std::fixed << std::setprecision(3)
+            << "  mean " << std::setw(8) << total / samples.size()
+            << "  p50 " << std::setw(8) << percentile(0.50)
+            << "  p95 " << std::setw(8) << percentile(0.95)
+            << "  max " << std::setw(8) << samples.back() << " ms" << std::endl;
+}
+
+}
+
+int RunHeadlessBenchmark(const GameConfig& config, int frames, const std::string& dumpPath) {
+  ServiceLocator::Initialize(config);
+  HeadlessGraphics graphics {
+    config.ScreenWidth,
+    config.ScreenHeight,
+    config.TileWidth,
+    config.TileHeight
+  };
+  graphics.SetInputScript(BuildScript(config, frames));
+
+  Clock::time_point start = Clock::now();
+  auto interface = std::make_unique<GameInterface>(config.ScreenWidth, config.ScreenHeight);
+  double worldMs = ElapsedMs(start);
+
+  start = Clock::now();
+  ServiceLocator::LoadResources(static_cast<ResourcesSystem&>(graphics));
+  double resourcesMs = ElapsedMs(start);
+
+  std::unique_ptr<CommandBufferRenderer> commandBuffer;
+  if (config.CommandBuffer) {
+    commandBuffer = std::make_unique<CommandBufferRenderer>(static_cast<RenderSystem&>(graphics));
+  }
+  RenderSystem& renderer = commandBuffer ? *commandBuffer : static_cast<RenderSystem&>(graphics);
+
+  std::vector<double> inputMs, updateMs, renderMs, frameMs;
+  long long textureDraws = 0, meshTriangles = 0;
+  for (int i = 0; i < frames; ++i) {
+    Clock::time_point frameStart = Clock::now();
+    interface->HandleInput(static_cast<InputSystem&>(graphics), static_cast<CollisionSystem&>(graphics));
+    inputMs.push_back(ElapsedMs(frameStart));
+
+    start = Clock::now();
+    interface->Update(static_cast<CollisionSystem&>(graphics));
+    updateMs.push_back(ElapsedMs(start));
+
+    start = Clock::now();
+    renderer.BeginDrawing();
+      interface->Render(renderer);
+    renderer.EndDrawing();
+    renderMs.push_back(ElapsedMs(start));
+    frameMs.push_back(ElapsedMs(frameStart));
+
+    textureDraws += graphics.LastFrameStats().textureDraws;
+    meshTriangles += graphics.LastFrameStats().meshTriangles;
+  }
+
+  std::cout << "Headless run: " << frames << " frames, " << config.WorldWidth << "x" << config.WorldHeight
+            << " world, mode " << config.RenderMode << (config.CommandBuffer ? " + command buffer" : "") << std::endl;
+  std::cout << std::fixed << std::setprecision(3)
+            << "World load " << worldMs << " ms, resources " << resourcesMs << " ms";
+  if (!frameMs.empty()) std::cout << ", first frame " << frameMs.front() << " ms";
+  std::cout << std::endl;
+  std::cout << "World build: " << interface->World().BuildStats().Describe() << std::endl;
+  TerrainRasterStats raster = interface->World().RasterStats();
+  if (raster.tiles > 0) std::cout << "Terrain raster: " << raster.Describe() << std::endl;
+  PrintSeries("input", inputMs);
+  PrintSeries("update", updateMs);
+  PrintSeries("render", renderMs);
+  PrintSeries("frame", frameMs);
+  if (frames > 0) {
+    std::cout << "Per frame: " << textureDraws / frames << " texture draws, "
+              << meshTriangles / frames << " mesh triangles" << std::endl;
+  }
+  std::cout << "Resident memory (terrain " << config.TerrainResidency << ", chunks " << config.ChunkResidency
+            << "): " << graphics.MemoryStats().Describe() << std::endl;
+  if (config.PagedTiles) {
+    std::cout << "Tile paging (budget " << config.PageBudgetMB << " MiB): "
+              << interface->World().PagingStats().Describe() << std::endl;
+  }
+
+  int status = 0;
+  if (!dumpPath.empty() && !graphics.ExportFrame(dumpPath.c_str())) {
+    std::cerr << "Failed to write frame to " << dumpPath << std::endl;
+    status = 1;
+  }
+
+  // Game objects hold handles into the backend, release them before it goes away;
+  // straight on the backend, the command buffer would defer the unloads to a next frame
+  start = Clock::now();
+  interface->Unload(static_cast<RenderSystem&>(graphics));
+  interface.reset();
+  ServiceLocator::UnloadResources(static_cast<ResourcesSystem&>(graphics));
+  std::cout << "Teardown " << ElapsedMs(start) << " ms" << std::endl;
+  commandBuffer.reset();
+  ServiceLocator::Shutdown();
+  return status;
+}
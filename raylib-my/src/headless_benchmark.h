@@ -0,0 +1,9 @@
+#pragma once
+
+#include <string>
+
+class GameConfig;
+
+// Runs the full GameInterface loop against HeadlessGraphics with a fixed input
+// script and prints load and per-frame timings. Returns a process exit code.
+int RunHeadlessBenchmark(const GameConfig& config, int frames, const std::string& dumpPath);
@@ -12,18 +12,14 @@ void DecorationMenuInputComponent::HandleInput(GameObject& menu, InputSystem& in
   DecorationMenu * decorationMenu = dynamic_cast<DecorationMenu *>(&menu);
   if (!decorationMenu) { throw GameError("Incorrect object type provided!"); }
   Position2D mouse = input.GetMousePosition();
-  int hoveredIndex = -1;
-
-  const auto& items = decorationMenu->Items();
-  const int itemCount = static_cast<int>(items.size());
-  for (int i = 0; i < itemCount; ++i) {
-    Rectangle2D rowRect = decorationMenu->ItemRect(i);
-    if (collision.CheckCollisionPointRec(mouse, rowRect)) {
-      hoveredIndex = i;
-      break;
-    }
+
+  // One wheel notch scrolls one row
+  float wheel = input.GetMouseWheelMove();
+  if (wheel != 0.0f) {
+    decorationMenu->ScrollRows(-wheel);
   }
 
+  int hoveredIndex = decorationMenu->ItemIndexAt(mouse);
   decorationMenu->SetHoveredIndex(hoveredIndex);
 
   constexpr int kMouseLeftButton = 0;
@@ -0,0 +1,39 @@
+#include "minimap_component.h"
+
+#include "../../common/game_object.h"
+#include "../../common/game_error.h"
+#include "../../common/grph_camera.h"
+#include "../../common/iso_projection.h"
+#include "../../config/game_config.h"
+#include "../../game_world.h"
+#include "../../menus/minimap.h"
+#include "../../graphics/input_system.h"
+#include "../../graphics/collision_system.h"
+#include "../../services/service_locator.h"
+
+MinimapInputComponent::MinimapInputComponent(): InputComponent() {}
+
+void MinimapInputComponent::HandleInput(GameObject& obj, InputSystem& input, CollisionSystem& collision) {
+  Minimap * minimap = dynamic_cast<Minimap *>(&obj);
+  if (!minimap) { throw GameError("Incorrect object type provided!"); }
+
+  constexpr int kMouseLeftButton = 0;
+  if (!input.IsMouseButtonPressed(kMouseLeftButton)) return;
+
+  Position2D mouse = input.GetMousePosition();
+  if (!collision.CheckCollisionPointRec(mouse, minimap->MapRect())) return;
+
+  const GameConfig& config = ServiceLocator::GetConfig();
+  IsoProjection projection(config.TileWidth, config.TileHeight);
+  Position2D world = projection.GridToWorld(minimap->MinimapToGrid(mouse));
+
+  // Shift the target by whatever separates the screen center from the clicked
+  // point, which keeps zoom and rotation as they are
+  GameCamera& camera = minimap->World().GetCamera();
+  GrphCamera view(camera.offset, camera.target, camera.rotation, camera.zoom);
+  Position2D center = view.ScreenToWorld({ config.ScreenWidth * 0.5f, config.ScreenHeight * 0.5f });
+  camera.target.x += world.x - center.x;
+  camera.target.y += world.y - center.y;
+}
+
+MinimapInputComponent::~MinimapInputComponent() {}
@@ -0,0 +1,15 @@
+#pragma once
+
+#include "../component.h"
+
+// Forward declarations
+class GameObject;
+class Minimap;
+
+// A left click centers the world camera on the clicked tile
+class MinimapInputComponent: public InputComponent {
+public:
+  MinimapInputComponent();
+  void virtual HandleInput(GameObject&, InputSystem&, CollisionSystem&) override;
+  ~MinimapInputComponent();
+};
@@ -2,6 +2,7 @@
 
 #include "../common/game_error.h"
 #include "../common/game_object.h"
+#include "../common/keyboard_2d.h"
 #include "../game_world.h"
 #include "../graphics/input_system.h"
 #include "../graphics/collision_system.h"
@@ -15,8 +16,8 @@ void WorldInputComponent::HandleInput(GameObject& wld, InputSystem& input, Colli
 
   world->GetCamera().HandleInput(input, collision);
 
-  for (int i = 0; i < world->MapWidth * world->MapHeight; ++i) {
-    world->GetTile(i).HandleInput(input, collision);
+  if (input.IsKeyPressed(Keyboard2D::KEY_G)) {
+    world->ToggleGrid();
   }
 }
 
@@ -1,6 +1,7 @@
 #include "decoration_menu.h"
 
 #include <algorithm>
+#include <cmath>
 
 #include "../services/service_locator.h"
 #include "../services/tiles_manager.h"
@@ -13,7 +14,9 @@ DecorationMenu::DecorationMenu(
 ):
   Menu(pos, std::move(inp), std::move(upd), std::move(grph)),
   hoveredIndex { -1 },
-  selectedIndex { -1 }
+  selectedIndex { -1 },
+  scrollOffset { 0.0f },
+  version { 0 }
 {
   const TilesManager& tilesManager = ServiceLocator::GetTilesManager();
   items = tilesManager.TileTypeNames();
@@ -33,15 +36,21 @@ int DecorationMenu::SelectedIndex() const {
 }
 
 void DecorationMenu::SetHoveredIndex(int index) {
-  hoveredIndex = IsIndexValid(index) ? index : -1;
+  int hovered = IsIndexValid(index) ? index : -1;
+  if (hovered == hoveredIndex) return;
+  hoveredIndex = hovered;
+  ++version;
 }
 
 void DecorationMenu::SetSelectedIndex(int index) {
-  selectedIndex = IsIndexValid(index) ? index : -1;
+  int selected = IsIndexValid(index) ? index : -1;
+  if (selected == selectedIndex) return;
+  selectedIndex = selected;
+  ++version;
 }
 
 Rectangle2D DecorationMenu::ItemRect(int index) const {
-  float y = Position.y + itemInsetY + index * (itemHeight + itemSpacing);
+  float y = Position.y + itemInsetY + index * itemPitch - scrollOffset;
   return {
     Position.x + itemInsetX,
     y,
@@ -50,6 +59,45 @@ Rectangle2D DecorationMenu::ItemRect(int index) const {
   };
 }
 
+int DecorationMenu::ItemIndexAt(Position2D point) const {
+  if (point.x < Position.x + itemInsetX || point.x >= Position.x + Position.width - itemInsetX) return -1;
+  if (point.y < Position.y || point.y >= Position.y + Position.height) return -1;
+
+  float local = point.y - Position.y - itemInsetY + scrollOffset;
+  if (local < 0.0f) return -1;
+  int index = static_cast<int>(local / itemPitch);
+  // Gap between two rows
+  if (local - index * itemPitch >= itemHeight) return -1;
+  return IsIndexValid(index) ? index : -1;
+}
+
+std::pair<int, int> DecorationMenu::VisibleItemRange() const {
+  int itemCount = static_cast<int>(items.size());
+  int first = static_cast<int>(std::floor((scrollOffset - itemInsetY) / itemPitch));
+  int last = static_cast<int>(std::ceil((scrollOffset + Position.height - itemInsetY) / itemPitch));
+  return { std::clamp(first, 0, itemCount), std::clamp(last, 0, itemCount) };
+}
+
+float DecorationMenu::ScrollOffset() const {
+  return scrollOffset;
+}
+
+float DecorationMenu::MaxScrollOffset() const {
+  float contentHeight = 2.0f * itemInsetY + items.size() * itemPitch - itemSpacing;
+  return std::max(0.0f, contentHeight - Position.height);
+}
+
+void DecorationMenu::ScrollRows(float rows) {
+  float offset = std::clamp(scrollOffset + rows * itemPitch, 0.0f, MaxScrollOffset());
+  if (offset == scrollOffset) return;
+  scrollOffset = offset;
+  ++version;
+}
+
+int DecorationMenu::Version() const {
+  return version;
+}
+
 bool DecorationMenu::IsIndexValid(int index) const {
   return index >= 0 && index < static_cast<int>(items.size());
 }
@@ -2,9 +2,11 @@
 
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "menu.h"
+#include "../common/position_2d.h"
 
 class DecorationMenu: public Menu {
   friend class MenuFactory;
@@ -22,16 +24,29 @@ public:
   int SelectedIndex() const;
   void SetHoveredIndex(int);
   void SetSelectedIndex(int);
+  // Rows are laid out at a fixed pitch, so lookups are arithmetic rather than a scan
   Rectangle2D ItemRect(int) const;
+  int ItemIndexAt(Position2D) const;
+  // Half-open [first, last) range of rows at least partly inside the panel
+  std::pair<int, int> VisibleItemRange() const;
+  float ScrollOffset() const;
+  float MaxScrollOffset() const;
+  // Scrolls by a number of rows, clamped to the content; fractions are allowed
+  void ScrollRows(float);
+  // Bumped whenever anything drawn by the menu changes
+  int Version() const;
 
 private:
   static constexpr float itemHeight = 50.0f;
   static constexpr float itemSpacing = 3.0f;
   static constexpr float itemInsetX = 4.0f;
   static constexpr float itemInsetY = 4.0f;
+  static constexpr float itemPitch = itemHeight + itemSpacing;
   bool IsIndexValid(int) const;
 
   std::vector<std::string> items;
   int hoveredIndex;
   int selectedIndex;
+  float scrollOffset;
+  int version;
 };
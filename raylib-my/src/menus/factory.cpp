@@ -4,6 +4,9 @@
 #include "../input_components/menu/decoration_menu_component.h"
 #include "../update_components/menu/decoration_menu_component.h"
 #include "../graphics_components/menu/decoration_menu_component.h"
+#include "../input_components/menu/minimap_component.h"
+#include "../update_components/menu/minimap_component.h"
+#include "../graphics_components/menu/minimap_component.h"
 
 std::unique_ptr<DecorationMenu> MenuFactory::CreateDecorationMenu(Rectangle2D pos) {
   auto inp_cmp = std::make_unique<DecorationMenuInputComponent>();
@@ -17,3 +20,17 @@ std::unique_ptr<DecorationMenu> MenuFactory::CreateDecorationMenu(Rectangle2D po
     std::move(grph_cmp)
   );
 }
+
+std::unique_ptr<Minimap> MenuFactory::CreateMinimap(Rectangle2D pos, GameWorld& world) {
+  auto inp_cmp = std::make_unique<MinimapInputComponent>();
+  auto upd_cmp = std::make_unique<MinimapUpdateComponent>();
+  auto grph_cmp = std::make_unique<MinimapGraphicsComponent>();
+
+  return std::make_unique<Minimap>(
+    pos,
+    world,
+    std::move(inp_cmp),
+    std::move(upd_cmp),
+    std::move(grph_cmp)
+  );
+}
@@ -3,8 +3,10 @@
 #include <memory>
 #include "menu.h"
 #include "decoration_menu.h"
+#include "minimap.h"
 
 class MenuFactory {
 public:
   static std::unique_ptr<DecorationMenu> CreateDecorationMenu(Rectangle2D);
+  static std::unique_ptr<Minimap> CreateMinimap(Rectangle2D, GameWorld&);
 };
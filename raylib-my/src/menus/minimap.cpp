@@ -0,0 +1,51 @@
+#include "minimap.h"
+
+#include <algorithm>
+
+#include "../game_world.h"
+
+Minimap::Minimap(
+  Rectangle2D pos,
+  GameWorld& world_,
+  std::unique_ptr<InputComponent> inp,
+  std::unique_ptr<UpdateComponent> upd,
+  std::unique_ptr<GraphicsComponent> grph
+):
+  Menu(pos, std::move(inp), std::move(upd), std::move(grph)),
+  world { world_ }
+{}
+
+GameWorld& Minimap::World() const {
+  return world;
+}
+
+Rectangle2D Minimap::MapRect() const {
+  float innerW = std::max(0.0f, Position.width - 2.0f * padding);
+  float innerH = std::max(0.0f, Position.height - 2.0f * padding);
+  float scale = std::min(innerW / float(world.MapWidth), innerH / float(world.MapHeight));
+  float w = float(world.MapWidth) * scale;
+  float h = float(world.MapHeight) * scale;
+
+  return {
+    Position.x + (Position.width - w) * 0.5f,
+    Position.y + (Position.height - h) * 0.5f,
+    w,
+    h
+  };
+}
+
+Position2D Minimap::GridToMinimap(Position2D grid) const {
+  Rectangle2D map = MapRect();
+  return {
+    map.x + grid.x * map.width / float(world.MapWidth),
+    map.y + grid.y * map.height / float(world.MapHeight)
+  };
+}
+
+Position2D Minimap::MinimapToGrid(Position2D screen) const {
+  Rectangle2D map = MapRect();
+  return {
+    (screen.x - map.x) * float(world.MapWidth) / map.width,
+    (screen.y - map.y) * float(world.MapHeight) / map.height
+  };
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <memory>
+
+#include "menu.h"
+#include "../common/position_2d.h"
+
+class GameWorld;
+
+// One pixel per tile, laid out in grid space (not isometric) and scaled to fit the panel
+class Minimap: public Menu {
+  friend class MenuFactory;
+
+public:
+  Minimap(
+    Rectangle2D,
+    GameWorld&,
+    std::unique_ptr<InputComponent>,
+    std::unique_ptr<UpdateComponent>,
+    std::unique_ptr<GraphicsComponent>
+  );
+
+  GameWorld& World() const;
+  // Part of the panel covered by the map, centered and aspect-preserving
+  Rectangle2D MapRect() const;
+  Position2D GridToMinimap(Position2D grid) const;
+  Position2D MinimapToGrid(Position2D screen) const;
+
+private:
+  static constexpr float padding = 4.0f;
+  GameWorld& world;
+};
@@ -1,6 +1,7 @@
 #include "service_locator.h"
 
 #include "tiles_manager.h"
+#include "../common/worker_pool.h"
 #include "../config/game_config.h"
 #include "../graphics/resources_system.h"
 
@@ -8,13 +9,16 @@
 
 std::unique_ptr<TilesManager> ServiceLocator::tilesManager = nullptr;
 std::unique_ptr<GameConfig> ServiceLocator::gameConfig = nullptr;
+std::unique_ptr<WorkerPool> ServiceLocator::workerPool = nullptr;
 
 void ServiceLocator::Initialize(const GameConfig& config) {
   tilesManager = std::make_unique<TilesManager>();
   gameConfig = std::make_unique<GameConfig>(config);
+  workerPool = std::make_unique<WorkerPool>(config.RasterThreads);
 }
 
 void ServiceLocator::Shutdown() {
+  workerPool.reset();
   tilesManager.reset();
   gameConfig.reset();
 }
@@ -24,11 +28,21 @@ void ServiceLocator::LoadResources(ResourcesSystem& resources) {
   tilesManager->LoadTextures(resources);
 }
 
+void ServiceLocator::UnloadResources(ResourcesSystem& resources) {
+  assert(tilesManager != nullptr && "ServiceLocator not initialized!");
+  tilesManager->UnloadTextures(resources);
+}
+
 TilesManager& ServiceLocator::GetTilesManager() {
   assert(tilesManager != nullptr && "ServiceLocator not initialized! Call ServiceLocator::Initialize() first.");
   return *tilesManager;
 }
 
+WorkerPool& ServiceLocator::GetWorkerPool() {
+  assert(workerPool != nullptr && "ServiceLocator not initialized! Call ServiceLocator::Initialize() first.");
+  return *workerPool;
+}
+
 const GameConfig& ServiceLocator::GetConfig() {
   assert(gameConfig != nullptr && "ServiceLocator config not initialized! Call ServiceLocator::Initialize() first.");
   return *gameConfig;
@@ -3,6 +3,7 @@
 #include <memory>
 
 class TilesManager;
+class WorkerPool;
 class ResourcesSystem;
 class GameConfig;
 
@@ -11,10 +12,13 @@ public:
   static void Initialize(const GameConfig& config);
   static void Shutdown();
   static void LoadResources(class ResourcesSystem& resources);
+  static void UnloadResources(ResourcesSystem& resources);
   static TilesManager& GetTilesManager();
+  static WorkerPool& GetWorkerPool();
   static const GameConfig& GetConfig();
 
 private:
   static std::unique_ptr<TilesManager> tilesManager;
   static std::unique_ptr<GameConfig> gameConfig;
+  static std::unique_ptr<WorkerPool> workerPool;
 };
@@ -1,7 +1,14 @@
 #include "tiles_manager.h"
 
+#include <algorithm>
+#include <cmath>
+
+#include "../common/color_2d.h"
 #include "../common/rectangle_2d.h"
 #include "../common/game_error.h"
+#include "../config/game_config.h"
+#include "service_locator.h"
+#include "../graphics/image_cache.h"
 #include "../graphics/resources_system.h"
 
 TilesManager::TilesManager() {
@@ -17,28 +24,136 @@ TilesManager::TilesManager() {
 
   tileTypes.try_emplace("Deep Water", "Deep Water", 0.5, true, "../../textures/ocean_sm.png", Rectangle2D{0, 0, 0, 0});
 
-  decorationTypes = {
-    { "Grass", WorldDecorationType::Grass },
-    { "Rock", WorldDecorationType::Rock },
-    { "Wall", WorldDecorationType::Wall },
-    { "Tree", WorldDecorationType::Tree },
-    { "Road", WorldDecorationType::Road }
+  // Flat colors picked to match the dominant tone of each terrain sprite
+  const std::unordered_map<std::string, Color2D> minimapColors {
+    { "Desert", Color2D(222, 196, 132) },
+    { "Plains", Color2D(176, 178, 92) },
+    { "Grassland", Color2D(104, 156, 60) },
+    { "ForestBg", Color2D(58, 112, 46) },
+    { "HillsBg", Color2D(140, 128, 80) },
+    { "MountainsBg", Color2D(128, 120, 112) },
+    { "Tundra", Color2D(150, 156, 132) },
+    { "Arctic", Color2D(232, 238, 244) },
+    { "Swamp", Color2D(88, 108, 72) },
+    { "Jungle", Color2D(40, 100, 40) },
+    { "Deep Water", Color2D(36, 72, 140) }
   };
+  for (const auto& [name, color] : minimapColors) {
+    tileTypes.at(name).AssignMinimapColor(color);
+  }
+
+  decorations.reserve(5);
+  decorations.emplace_back(WorldDecorationType::Grass, "Grass");
+  decorations.emplace_back(WorldDecorationType::Rock, "Rock");
+  decorations.emplace_back(WorldDecorationType::Wall, "Wall");
+  decorations.emplace_back(WorldDecorationType::Tree, "Tree");
+  decorations.emplace_back(WorldDecorationType::Road, "Road");
 
-  resourceTypes = {
-    { "Coil", ResourceType::Coil },
-    { "Clay", ResourceType::Clay },
-    { "Iron", ResourceType::Iron },
-    { "Copper", ResourceType::Copper }
+  resources.reserve(4);
+  resources.emplace_back(ResourceType::Coil, "Coil");
+  resources.emplace_back(ResourceType::Clay, "Clay");
+  resources.emplace_back(ResourceType::Iron, "Iron");
+  resources.emplace_back(ResourceType::Copper, "Copper");
+
+  // Closest specials from the terrain sheet until dedicated decoration art exists
+  auto sheetCell = [](int column, int row) {
+    return Rectangle2D { 97.0f * column + 1.0f, 49.0f * row + 1.0f, 96.0f, 48.0f };
+  };
+  overlaySheetPath = txr;
+  decorationSprites = {
+    { WorldDecorationType::Grass, sheetCell(4, 1) },
+    { WorldDecorationType::Rock, sheetCell(6, 3) },
+    { WorldDecorationType::Wall, sheetCell(6, 5) },
+    { WorldDecorationType::Tree, sheetCell(2, 0) },
+    { WorldDecorationType::Road, sheetCell(0, 12) }
+  };
+  resourceSprites = {
+    { ResourceType::Coil, sheetCell(2, 3) },
+    { ResourceType::Clay, sheetCell(2, 7) },
+    { ResourceType::Iron, sheetCell(4, 5) },
+    { ResourceType::Copper, sheetCell(2, 4) }
   };
 }
 
 void TilesManager::LoadTextures(ResourcesSystem& resources) {
+  const GameConfig& config = ServiceLocator::GetConfig();
+  // Most types and the overlay sheet share one PNG; decode it once and crop from memory
+  ImageCache sourceImages(resources);
   for (auto& [name, tileType]: tileTypes) {
-    tileType.LoadTexture(resources);
+    tileType.LoadTexture(resources, sourceImages);
+    tileType.BuildSprites(resources, config.TileWidth, config.TileHeight);
+  }
+  BuildAtlas(resources);
+  overlaySheet = resources.LoadTextureFromImage(sourceImages.Get(overlaySheetPath));
+
+  // Sprites and atlas are baked, so the per-type copies are only kept on request
+  Residency terrainResidency = ParseResidency(config.TerrainResidency);
+  for (auto& [name, tileType]: tileTypes) {
+    tileType.ApplyResidency(resources, terrainResidency);
   }
 }
 
+void TilesManager::BuildAtlas(ResourcesSystem& resources) {
+  int cellWidth = 0;
+  int cellHeight = 0;
+  for (const auto& [name, tileType]: tileTypes) {
+    cellWidth = std::max(cellWidth, resources.GetImageWidth(tileType.TextureImage()));
+    cellHeight = std::max(cellHeight, resources.GetImageHeight(tileType.TextureImage()));
+  }
+  cellWidth += 2 * atlasPadding;
+  cellHeight += 2 * atlasPadding;
+
+  int columns = static_cast<int>(std::ceil(std::sqrt(static_cast<float>(tileTypes.size()))));
+  int rows = (static_cast<int>(tileTypes.size()) + columns - 1) / columns;
+  ImageHandle atlasImage = resources.GenImageColor(columns * cellWidth, rows * cellHeight, Color2D(0, 0, 0, 0));
+
+  int cell = 0;
+  for (auto& [name, tileType]: tileTypes) {
+    ImageHandle image = tileType.TextureImage();
+    float width = static_cast<float>(resources.GetImageWidth(image));
+    float height = static_cast<float>(resources.GetImageHeight(image));
+    Rectangle2D slot {
+      static_cast<float>((cell % columns) * cellWidth + atlasPadding),
+      static_cast<float>((cell / columns) * cellHeight + atlasPadding),
+      width,
+      height
+    };
+    resources.ImageDraw(atlasImage, image, { 0, 0, width, height }, slot, Color2D::White());
+    tileType.AssignAtlasRect(slot);
+    ++cell;
+  }
+
+  atlas = resources.LoadTextureFromImage(atlasImage);
+  resources.UnloadImage(atlasImage);
+}
+
+void TilesManager::UnloadTextures(ResourcesSystem& resources) {
+  if (atlas.IsValid()) {
+    resources.UnloadTexture(atlas);
+    atlas = TextureHandle();
+  }
+  if (overlaySheet.IsValid()) {
+    resources.UnloadTexture(overlaySheet);
+    overlaySheet = TextureHandle();
+  }
+}
+
+TextureHandle TilesManager::Atlas() const {
+  return atlas;
+}
+
+TextureHandle TilesManager::OverlaySheet() const {
+  return overlaySheet;
+}
+
+Rectangle2D TilesManager::DecorationSprite(WorldDecorationType type) const {
+  return decorationSprites.at(type);
+}
+
+Rectangle2D TilesManager::ResourceSprite(ResourceType type) const {
+  return resourceSprites.at(type);
+}
+
 std::vector<std::string> TilesManager::TileTypeNames() const {
   std::vector<std::string> keys;
   keys.reserve(tileTypes.size());
@@ -52,31 +167,35 @@ const std::unordered_map<std::string, WorldTileTerrainType> &TilesManager::TileT
   return tileTypes;
 }
 
-WorldTile* TilesManager::NewTile(std::string typeName, Position2D pos) const {
-  return Type(typeName).NewTile(pos);
-}
-
-WorldDecorationType TilesManager::DecorationTypeByName(const std::string& name) const {
-  auto it = decorationTypes.find(name);
-  if (it == decorationTypes.end()) {
-    throw GameError("Unknown decoration type name: " + name);
+const WorldTileTerrainType& TilesManager::TerrainType(const std::string& typeName) const {
+  auto it = tileTypes.find(typeName);
+  if (it == tileTypes.end()) {
+    throw GameError("Unknown tile type name: " + typeName);
   }
   return it->second;
 }
 
-ResourceType TilesManager::ResourceTypeByName(const std::string& name) const {
-  auto it = resourceTypes.find(name);
-  if (it == resourceTypes.end()) {
-    throw GameError("Unknown resource type name: " + name);
-  }
-  return it->second;
+const WorldTileDecoration& TilesManager::Decoration(WorldDecorationType type) const {
+  return decorations.at(static_cast<size_t>(type));
+}
+
+const WorldTileResource& TilesManager::Resource(ResourceType type) const {
+  return resources.at(static_cast<size_t>(type));
+}
+
+const WorldTileDecoration* TilesManager::FindDecoration(const std::string& name) const {
+  auto it = std::find_if(decorations.begin(), decorations.end(),
+    [&name](const WorldTileDecoration& decoration) { return decoration.Name == name; });
+  return it == decorations.end() ? nullptr : &*it;
 }
 
-const WorldTileTerrainType& TilesManager::Type(std::string typeName) const {
-  return tileTypes.at(typeName);
+const WorldTileResource* TilesManager::FindResource(const std::string& name) const {
+  auto it = std::find_if(resources.begin(), resources.end(),
+    [&name](const WorldTileResource& resource) { return resource.Name == name; });
+  return it == resources.end() ? nullptr : &*it;
 }
 
 TilesManager::~TilesManager() {
-  // TODO: Need to pass Graphics/ResourcesSystem to properly unload textures
-  // For now, textures will be unloaded when Graphics is destroyed
+  // TODO: Per-type textures still need a ResourcesSystem to unload, see UnloadTextures
+  // For now, they are unloaded when Graphics is destroyed
 }
@@ -4,7 +4,6 @@
 #include <vector>
 #include <string>
 
-#include "../world_tiles/tile.h"
 #include "../world_tiles/tile_terrain_type.h"
 #include "../world_tiles/decorations/decoration.h"
 #include "../world_tiles/resources/resource.h"
@@ -16,16 +15,36 @@ class TilesManager {
 public:
   TilesManager();
   void LoadTextures(ResourcesSystem& resources);
-  WorldTile* NewTile(std::string, Position2D) const;
+  // Releases the atlas and overlay sheet shared by the world renderers
+  void UnloadTextures(ResourcesSystem& resources);
+  const WorldTileTerrainType& TerrainType(const std::string&) const;
   std::vector<std::string> TileTypeNames() const;
-  WorldDecorationType DecorationTypeByName(const std::string&) const;
-  ResourceType ResourceTypeByName(const std::string&) const;
+  // Shared decoration and resource records; tiles refer to them by type
+  const WorldTileDecoration& Decoration(WorldDecorationType) const;
+  const WorldTileResource& Resource(ResourceType) const;
+  // nullptr for unknown names
+  const WorldTileDecoration* FindDecoration(const std::string&) const;
+  const WorldTileResource* FindResource(const std::string&) const;
   ~TilesManager();
   const std::unordered_map<std::string, WorldTileTerrainType> &TileTypes();
+  TextureHandle Atlas() const;
+  // Decoration and resource sprites share one sheet texture so the overlay draws as one batch
+  TextureHandle OverlaySheet() const;
+  Rectangle2D DecorationSprite(WorldDecorationType) const;
+  Rectangle2D ResourceSprite(ResourceType) const;
 
 private:
-  const WorldTileTerrainType& Type(std::string) const;
+  static constexpr int atlasPadding = 2;
+
+  void BuildAtlas(ResourcesSystem& resources);
+
+  TextureHandle atlas;
+  std::string overlaySheetPath;
+  TextureHandle overlaySheet;
+  std::unordered_map<WorldDecorationType, Rectangle2D> decorationSprites;
+  std::unordered_map<ResourceType, Rectangle2D> resourceSprites;
   std::unordered_map<std::string, WorldTileTerrainType> tileTypes;
-  std::unordered_map<std::string, WorldDecorationType> decorationTypes;
-  std::unordered_map<std::string, ResourceType> resourceTypes;
+  // Indexed by the enum value
+  std::vector<WorldTileDecoration> decorations;
+  std::vector<WorldTileResource> resources;
 };
@@ -0,0 +1,15 @@
+#include "minimap_component.h"
+
+#include "../../common/game_object.h"
+#include "../../common/game_error.h"
+#include "../../menus/minimap.h"
+#include "../../graphics/collision_system.h"
+
+MinimapUpdateComponent::MinimapUpdateComponent(): UpdateComponent() {}
+
+void MinimapUpdateComponent::Update(GameObject& obj, CollisionSystem& collision) {
+  Minimap * minimap = dynamic_cast<Minimap *>(&obj);
+  if (!minimap) { throw GameError("Incorrect object type provided!"); }
+}
+
+MinimapUpdateComponent::~MinimapUpdateComponent() {}
@@ -0,0 +1,14 @@
+#pragma once
+
+#include "../component.h"
+
+// Forward declarations
+class GameObject;
+class Minimap;
+
+class MinimapUpdateComponent: public UpdateComponent {
+public:
+  MinimapUpdateComponent();
+  void virtual Update(GameObject&, CollisionSystem&) override;
+  ~MinimapUpdateComponent();
+};
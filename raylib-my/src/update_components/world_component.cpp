@@ -12,9 +12,8 @@ void WorldUpdateComponent::Update(GameObject& wld, CollisionSystem& collision) {
 
   if (!world) throw GameError("Incorrect object type provided!");
 
-  for (int i = 0; i < world->MapWidth * world->MapHeight; ++i) {
-    world->GetTile(i).Update(collision);
-  }
+  world->BeginFrame();
+  world->UpdateSystems();
 }
 
 WorldUpdateComponent::~WorldUpdateComponent() {}
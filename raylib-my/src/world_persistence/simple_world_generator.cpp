@@ -1,6 +1,7 @@
 #include "simple_world_generator.h"
 
 #include <limits>
+#include <string>
 
 #include "../common/game_error.h"
 
@@ -36,6 +37,19 @@ std::optional<WorldTileData> SimpleWorldGenerator::NextTile() {
   return BuildTile(x, y);
 }
 
+bool SimpleWorldGenerator::SupportsTileAt() const {
+  return true;
+}
+
+// Tiles are a pure function of position, so any tile can be produced in any order
+WorldTileData SimpleWorldGenerator::TileAt(int x, int y) {
+  EnsureInitialized();
+  if (x < 0 || y < 0 || x >= width || y >= height) {
+    throw GameError("Tile out of generated world at x: " + std::to_string(x) + ", y: " + std::to_string(y));
+  }
+  return BuildTile(x, y);
+}
+
 void SimpleWorldGenerator::EnsureInitialized() {
   if (initialized) return;
 
@@ -54,8 +68,8 @@ void SimpleWorldGenerator::EnsureInitialized() {
   meta.width = width;
   meta.height = height;
   meta.tileTypeNamesById = { "Deep Water", "Plains", "Grassland" };
-  meta.decorationNamesById = { "" };
-  meta.resourceNamesById = { "" };
+  meta.decorationNamesById = { "", "Tree", "Rock" };
+  meta.resourceNamesById = { "", "Iron" };
 
   initialized = true;
 }
@@ -76,5 +90,20 @@ WorldTileData SimpleWorldGenerator::BuildTile(int x, int y) const {
   }
 
   tile.tileTypeId = 2;
+
+  // Deterministic scatter so generated grassland is not empty
+  const uint32_t hash = (static_cast<uint32_t>(x) * 73856093u) ^ (static_cast<uint32_t>(y) * 19349663u);
+  if (hash % 11 == 0) {
+    tile.decorationTypeId = 1;
+  } else if (hash % 13 == 0) {
+    tile.decorationTypeId = 2;
+  }
+  if (tile.decorationTypeId != 0) {
+    tile.decorationState = 0;
+  }
+  if (hash % 31 == 0) {
+    tile.resourceTypeId = 1;
+    tile.resourceVolume = 500;
+  }
   return tile;
 }
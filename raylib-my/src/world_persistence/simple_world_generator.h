@@ -12,6 +12,8 @@ public:
   WorldMeta ReadMeta() override;
   void BeginTileScan() override;
   std::optional<WorldTileData> NextTile() override;
+  bool SupportsTileAt() const override;
+  WorldTileData TileAt(int x, int y) override;
 
 private:
   int width;
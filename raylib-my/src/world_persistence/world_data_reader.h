@@ -5,6 +5,7 @@
 #include <string>
 #include <vector>
 
+#include "../common/game_error.h"
 #include "../common/position_2d.h"
 
 struct CameraState {
@@ -39,4 +40,10 @@ public:
   virtual WorldMeta ReadMeta() = 0;
   virtual void BeginTileScan() = 0;
   virtual std::optional<WorldTileData> NextTile() = 0;
+  // Readers that can fetch any tile without scanning let paged worlds load chunks on demand
+  virtual bool SupportsTileAt() const { return false; }
+  virtual WorldTileData TileAt(int x, int y) {
+    throw GameError("Tile reader does not support random access, requested x: " + std::to_string(x)
+      + ", y: " + std::to_string(y));
+  }
 };
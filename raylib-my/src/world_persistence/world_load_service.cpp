@@ -3,87 +3,57 @@
 #include <limits>
 #include <string>
 
+namespace {
+
+WorldDataReader& requireReader(const std::shared_ptr<WorldDataReader>& reader) {
+  if (!reader) {
+    throw GameError("WorldLoadService requires a reader");
+  }
+  return *reader;
+}
+
+}
+
 // TODO: This class carries too much validation and implicit contract knowledge.
 //   It depends on WorldMeta and WorldTileData rules (name tables must be complete, id 0 means
 //   empty resources/decorations, decorationState/resourceVolume presence rules, etc).
 //   Refactor after Task-19 to separate validation from construction.
 WorldLoadService::WorldLoadService(const TilesManager& tilesMngr, WorldDataReader& rdr, WorldBuilder builder):
+  sharedReader { },
   reader { rdr },
   worldMeta { },
   tilesManager { tilesMngr },
   worldBuilder { std::move(builder) }
 {}
 
-std::unique_ptr<WorldTileDecoration> WorldLoadService::BuildDecoration(const std::string& decoration_name) const {
-  return std::make_unique<WorldTileDecoration>(
-    tilesManager.DecorationTypeByName(decoration_name),
-    decoration_name
-  );
-}
-
-std::unique_ptr<WorldTileResource> WorldLoadService::BuildResource(const std::string& resource_name, uint32_t volume) const {
-  return std::make_unique<WorldTileResource>(
-    tilesManager.ResourceTypeByName(resource_name),
-    resource_name,
-    volume
-  );
-}
+WorldLoadService::WorldLoadService(const TilesManager& tilesMngr, std::shared_ptr<WorldDataReader> rdr, WorldBuilder builder):
+  sharedReader { std::move(rdr) },
+  reader { requireReader(sharedReader) },
+  worldMeta { },
+  tilesManager { tilesMngr },
+  worldBuilder { std::move(builder) }
+{}
 
-std::unique_ptr<WorldTile> WorldLoadService::ProvideTile(int x, int y) const {
+WorldTileInit WorldLoadService::ProvideTile(int x, int y) const {
   std::optional<WorldTileData> tileDataOpt = reader.NextTile();
   if (!tileDataOpt.has_value()) {
     throw GameError("Unexpected end of tile stream at x: " + std::to_string(x) + ", y: " + std::to_string(y));
   }
-  const WorldTileData& tileData = *tileDataOpt;
-
-  if (tileData.tileTypeId >= worldMeta.tileTypeNamesById.size()) {
-    throw GameError("Unknown tileTypeId=" + std::to_string(tileData.tileTypeId) +
-      " at x: " + std::to_string(x) + ", y: " + std::to_string(y));
-  }
-
-  const Position2D pos { static_cast<float>(x) + 0.5f, static_cast<float>(y) + 0.5f };
-
-  const std::string& tileTypeName = worldMeta.tileTypeNamesById[tileData.tileTypeId];
-  if (tileTypeName.empty()) {
-    throw GameError("Missing tile type name for tileTypeId=" + std::to_string(tileData.tileTypeId));
-  }
-
-  std::unique_ptr<WorldTile> tile { tilesManager.NewTile(tileTypeName, pos) };
-
-  if (tileData.decorationTypeId != 0) {
-    if (tileData.decorationTypeId >= worldMeta.decorationNamesById.size()) {
-      throw GameError("Unknown decorationTypeId=" + std::to_string(tileData.decorationTypeId) +
-        " at x: " + std::to_string(x) + ", y: " + std::to_string(y));
-    }
-    const std::string& decorationName = worldMeta.decorationNamesById[tileData.decorationTypeId];
-    if (decorationName.empty()) {
-      throw GameError("Missing decoration type name for decorationTypeId="
-        + std::to_string(tileData.decorationTypeId));
-    }
-    tile->Decoration = BuildDecoration(decorationName);
-  }
-
-  if (tileData.resourceTypeId != 0) {
-    if (tileData.resourceTypeId >= worldMeta.resourceNamesById.size()) {
-      throw GameError("Unknown resourceTypeId=" + std::to_string(tileData.resourceTypeId) +
-        " at x: " + std::to_string(x) + ", y: " + std::to_string(y));
-    }
-    if (!tileData.resourceVolume.has_value()) {
-      throw GameError("Missing resource volume at x: " + std::to_string(x) + ", y: " + std::to_string(y));
-    }
-    const std::string& resourceName = worldMeta.resourceNamesById[tileData.resourceTypeId];
-    if (resourceName.empty()) {
-      throw GameError("Missing resource type name for resourceTypeId="
-        + std::to_string(tileData.resourceTypeId));
-    }
-    tile->Resource = BuildResource(resourceName, *tileData.resourceVolume);
-  }
+  return decoder->Decode(*tileDataOpt, x, y);
+}
 
-  return tile;
+// Holds its own references to the reader and decoder, never to this service
+GameWorld::TileProvider WorldLoadService::RandomAccessProvider() const {
+  std::shared_ptr<WorldDataReader> source = sharedReader;
+  std::shared_ptr<const WorldTileDecoder> tileDecoder = decoder;
+  return [source, tileDecoder](int x, int y) {
+    return tileDecoder->Decode(source->TileAt(x, y), x, y);
+  };
 }
 
 std::unique_ptr<GameWorld> WorldLoadService::BuildWorld() {
   worldMeta = reader.ReadMeta();
+  decoder = std::make_shared<WorldTileDecoder>(tilesManager, worldMeta);
 
   if (worldMeta.width <= 0 || worldMeta.height <= 0) {
     throw GameError("World dimensions must be positive");
@@ -97,18 +67,23 @@ std::unique_ptr<GameWorld> WorldLoadService::BuildWorld() {
   }
 
   const size_t tileCount = widthSize * heightSize;
-  reader.BeginTileScan();
 
   if (!worldBuilder) {
     throw GameError("WorldLoadService requires a world builder");
   }
 
-  auto world = worldBuilder(worldMeta.width, worldMeta.height, [this](int x, int y) {
-    return ProvideTile(x, y);
-  });
-
-  if (reader.NextTile().has_value()) {
-    throw GameError("Extra tile data after expected tile count: " + std::to_string(tileCount));
+  std::unique_ptr<GameWorld> world;
+  if (sharedReader && reader.SupportsTileAt()) {
+    world = worldBuilder(worldMeta.width, worldMeta.height, RandomAccessProvider());
+  } else {
+    reader.BeginTileScan();
+    world = worldBuilder(worldMeta.width, worldMeta.height, [this](int x, int y) {
+      return ProvideTile(x, y);
+    });
+
+    if (reader.NextTile().has_value()) {
+      throw GameError("Extra tile data after expected tile count: " + std::to_string(tileCount));
+    }
   }
 
   if (worldMeta.camera.has_value()) {
@@ -3,6 +3,7 @@
 #include <memory>
 #include <functional>
 #include <string>
+#include <vector>
 
 #include "../common/game_error.h"
 #include "../game_world.h"
@@ -11,21 +12,26 @@
 #include "../world_tiles/resources/resource.h"
 
 #include "world_data_reader.h"
+#include "world_tile_decoder.h"
 
 class WorldLoadService {
 public:
   using WorldBuilder = std::function<std::unique_ptr<GameWorld>(int, int, GameWorld::TileProvider)>;
 
   WorldLoadService(const TilesManager& tiles_manager, WorldDataReader& reader, WorldBuilder world_builder);
+  // Shares ownership of the reader, so when it supports random access the world
+  // gets a provider that stays valid after the load and can fetch tiles on demand
+  WorldLoadService(const TilesManager& tiles_manager, std::shared_ptr<WorldDataReader> reader, WorldBuilder world_builder);
   std::unique_ptr<GameWorld> BuildWorld();
 
 private:
+  std::shared_ptr<WorldDataReader> sharedReader;
   WorldDataReader& reader;
   WorldMeta worldMeta;
   const TilesManager& tilesManager;
   WorldBuilder worldBuilder;
+  std::shared_ptr<const WorldTileDecoder> decoder;
 
-  std::unique_ptr<WorldTileDecoration> BuildDecoration(const std::string& decoration_name) const;
-  std::unique_ptr<WorldTileResource> BuildResource(const std::string& resource_name, uint32_t volume) const;
-  std::unique_ptr<WorldTile> ProvideTile(int x, int y) const;
+  WorldTileInit ProvideTile(int x, int y) const;
+  GameWorld::TileProvider RandomAccessProvider() const;
 };
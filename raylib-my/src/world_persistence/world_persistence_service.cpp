@@ -1,12 +1,18 @@
 #include "world_persistence_service.h"
 
+#include <cmath>
+
 #include "../common/game_error.h"
+#include "../common/residency.h"
 #include "../config/game_config.h"
 #include "../services/tiles_manager.h"
 #include "../input_components/world_component.h"
-#include "../graphics_components/world_component.h"
+#include "../graphics_components/world_atlas_component.h"
+#include "../graphics_components/world_image_component.h"
+#include "../graphics_components/world_mesh_component.h"
 #include "../update_components/world_component.h"
 #include "../services/service_locator.h"
+#include "../world_systems/tree_growth_system.h"
 
 #include "simple_world_generator.h"
 #include "world_load_service.h"
@@ -29,8 +35,19 @@ std::unique_ptr<GameWorld> WorldPersistenceService::LoadWorld() {
 }
 
 std::unique_ptr<GameWorld> WorldPersistenceService::GenerateWorld() {
+  auto builder = [this](int width, int height, GameWorld::TileProvider tilesProvider) {
+    return BuildWorldWithTiles(width, height, std::move(tilesProvider));
+  };
+
+  // A paged world regenerates chunks on demand, so the generator must outlive the load
+  if (config.PagedTiles) {
+    auto generator = std::make_shared<SimpleWorldGenerator>(config.WorldWidth, config.WorldHeight);
+    WorldLoadService loader { tilesManager, std::move(generator), builder };
+    return loader.BuildWorld();
+  }
+
   SimpleWorldGenerator generator { config.WorldWidth, config.WorldHeight };
-  WorldLoadService loader { tilesManager, generator, BuildWorldWithTiles };
+  WorldLoadService loader { tilesManager, generator, builder };
   return loader.BuildWorld();
 }
 
@@ -38,16 +55,46 @@ void WorldPersistenceService::SaveWorld(const GameWorld&) {
   throw GameError("World save is not available yet. Save/load pipeline is still in progress.");
 }
 
+std::unique_ptr<GraphicsComponent> WorldPersistenceService::BuildWorldGraphicsComponent() const {
+  if (config.RenderMode == "atlas") {
+    return std::make_unique<WorldAtlasGraphicsComponent>();
+  }
+  if (config.RenderMode == "mesh") {
+    return std::make_unique<WorldMeshGraphicsComponent>();
+  }
+  // One pyramid level per halving of zoom down to the configured minimum
+  int lodLevels = 1 + static_cast<int>(std::ceil(std::log2(1.0f / config.ZoomMin)));
+  bool keepChunkImages = KeepsCpuCopy(ParseResidency(config.ChunkResidency));
+  return std::make_unique<WorldImageGraphicsComponent>(lodLevels, keepChunkImages);
+}
+
+WorldPagingOptions WorldPersistenceService::PagingOptions() const {
+  WorldPagingOptions paging;
+  paging.enabled = config.PagedTiles;
+  paging.chunkSize = config.PageChunkSize;
+  paging.budgetBytes = static_cast<size_t>(config.PageBudgetMB) * 1024 * 1024;
+  paging.pageFile = config.PageFile;
+  return paging;
+}
+
 std::unique_ptr<GameWorld> WorldPersistenceService::BuildWorldWithTiles(
   int width,
   int height,
   GameWorld::TileProvider tilesProvider
-) {
-  return std::make_unique<GameWorld>(
+) const {
+  auto world = std::make_unique<GameWorld>(
     width, height,
     std::make_unique<WorldInputComponent>(),
-    std::make_unique<WorldGraphicsComponent>(),
+    BuildWorldGraphicsComponent(),
     std::make_unique<WorldUpdateComponent>(),
-    std::move(tilesProvider)
+    std::move(tilesProvider),
+    config.ZoomMin,
+    PagingOptions()
   );
+
+  constexpr int treeTicksPerStage = 600;
+  world->RegisterSystem(std::make_unique<TreeGrowthSystem>(
+    tilesManager.Decoration(WorldDecorationType::Tree), treeTicksPerStage));
+
+  return world;
 }
@@ -21,5 +21,7 @@ private:
   const GameConfig& config;
   const TilesManager& tilesManager;
 
-  static std::unique_ptr<GameWorld> BuildWorldWithTiles(int width, int height, GameWorld::TileProvider tilesProvider);
+  std::unique_ptr<GraphicsComponent> BuildWorldGraphicsComponent() const;
+  WorldPagingOptions PagingOptions() const;
+  std::unique_ptr<GameWorld> BuildWorldWithTiles(int width, int height, GameWorld::TileProvider tilesProvider) const;
 };
@@ -0,0 +1,75 @@
+#include "world_tile_decoder.h"
+
+#include <string>
+
+#include "../common/game_error.h"
+
+WorldTileDecoder::WorldTileDecoder(const TilesManager& tilesMngr, const WorldMeta& meta):
+  tilesManager { tilesMngr },
+  worldMeta { meta },
+  decorationsById { },
+  resourcesById { }
+{
+  for (const std::string& name : worldMeta.decorationNamesById) {
+    decorationsById.push_back(name.empty() ? nullptr : tilesManager.FindDecoration(name));
+  }
+  for (const std::string& name : worldMeta.resourceNamesById) {
+    resourcesById.push_back(name.empty() ? nullptr : tilesManager.FindResource(name));
+  }
+}
+
+WorldTileInit WorldTileDecoder::Decode(const WorldTileData& tileData, int x, int y) const {
+  if (tileData.tileTypeId >= worldMeta.tileTypeNamesById.size()) {
+    throw GameError("Unknown tileTypeId=" + std::to_string(tileData.tileTypeId) +
+      " at x: " + std::to_string(x) + ", y: " + std::to_string(y));
+  }
+
+  const std::string& tileTypeName = worldMeta.tileTypeNamesById[tileData.tileTypeId];
+  if (tileTypeName.empty()) {
+    throw GameError("Missing tile type name for tileTypeId=" + std::to_string(tileData.tileTypeId));
+  }
+
+  WorldTileInit tile;
+  tile.terrain = &tilesManager.TerrainType(tileTypeName);
+
+  if (tileData.decorationTypeId != 0) {
+    if (tileData.decorationTypeId >= worldMeta.decorationNamesById.size()) {
+      throw GameError("Unknown decorationTypeId=" + std::to_string(tileData.decorationTypeId) +
+        " at x: " + std::to_string(x) + ", y: " + std::to_string(y));
+    }
+    const WorldTileDecoration* decoration = decorationsById[tileData.decorationTypeId];
+    if (!decoration) {
+      const std::string& decorationName = worldMeta.decorationNamesById[tileData.decorationTypeId];
+      if (decorationName.empty()) {
+        throw GameError("Missing decoration type name for decorationTypeId="
+          + std::to_string(tileData.decorationTypeId));
+      }
+      throw GameError("Unknown decoration type name: " + decorationName);
+    }
+    tile.decoration = decoration;
+    tile.decorationState = tileData.decorationState.value_or(0);
+  }
+
+  if (tileData.resourceTypeId != 0) {
+    if (tileData.resourceTypeId >= worldMeta.resourceNamesById.size()) {
+      throw GameError("Unknown resourceTypeId=" + std::to_string(tileData.resourceTypeId) +
+        " at x: " + std::to_string(x) + ", y: " + std::to_string(y));
+    }
+    if (!tileData.resourceVolume.has_value()) {
+      throw GameError("Missing resource volume at x: " + std::to_string(x) + ", y: " + std::to_string(y));
+    }
+    const WorldTileResource* resource = resourcesById[tileData.resourceTypeId];
+    if (!resource) {
+      const std::string& resourceName = worldMeta.resourceNamesById[tileData.resourceTypeId];
+      if (resourceName.empty()) {
+        throw GameError("Missing resource type name for resourceTypeId="
+          + std::to_string(tileData.resourceTypeId));
+      }
+      throw GameError("Unknown resource type name: " + resourceName);
+    }
+    tile.resource = resource;
+    tile.resourceVolume = *tileData.resourceVolume;
+  }
+
+  return tile;
+}
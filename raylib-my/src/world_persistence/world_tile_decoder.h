@@ -0,0 +1,22 @@
+#pragma once
+
+#include <vector>
+
+#include "../services/tiles_manager.h"
+#include "../world_tiles/tile_storage.h"
+#include "world_data_reader.h"
+
+// Turns save-file tile records into WorldTileInit against one world's name tables.
+// Type ids are resolved to the shared records once, nullptr for empty or unknown
+// names; the error is raised only if a tile uses that id.
+class WorldTileDecoder {
+public:
+  WorldTileDecoder(const TilesManager&, const WorldMeta&);
+  WorldTileInit Decode(const WorldTileData&, int x, int y) const;
+
+private:
+  const TilesManager& tilesManager;
+  WorldMeta worldMeta;
+  std::vector<const WorldTileDecoration*> decorationsById;
+  std::vector<const WorldTileResource*> resourcesById;
+};
@@ -0,0 +1,7 @@
+#include "tile_system.h"
+
+TileSystem::~TileSystem() {}
+
+uint8_t TileSystem::RequiredFlags() const {
+  return 0;
+}
@@ -0,0 +1,23 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+// Forward declarations
+class GameWorld;
+class WorldTileView;
+
+// A behavior that applies to a subset of tiles. The world keeps the set of tiles
+// each system wants up to date, so a tick costs one virtual call per system and
+// one loop iteration per active tile, however large the map is.
+class TileSystem {
+public:
+  virtual ~TileSystem();
+  virtual const char* Name() const = 0;
+  // Tiles lacking any of these storage flags are skipped without calling Wants,
+  // which keeps the initial scan of a large world cheap
+  virtual uint8_t RequiredFlags() const;
+  virtual bool Wants(const WorldTileView&) const = 0;
+  // Membership changes made while the systems run take effect after the tick
+  virtual void Update(GameWorld&, const std::vector<int>& activeTiles) = 0;
+};
@@ -0,0 +1,148 @@
+#include "tile_system_registry.h"
+
+#include <string>
+
+#include "../common/game_error.h"
+#include "../common/tile_range.h"
+#include "../world_tiles/tile_storage.h"
+#include "../world_tiles/tile_view.h"
+
+TileSystemRegistry::TileSystemRegistry():
+  entries { },
+  running { false },
+  pendingEvents { }
+{}
+
+void TileSystemRegistry::Register(std::unique_ptr<TileSystem> system, const WorldTileStorage& tiles) {
+  if (!system) {
+    throw GameError("Cannot register a null tile system");
+  }
+
+  Entry entry { std::move(system), { }, { } };
+  for (int chunk : tiles.ResidentChunks()) {
+    scanChunk(entry, tiles, chunk);
+  }
+  entries.push_back(std::move(entry));
+}
+
+void TileSystemRegistry::TileChanged(const WorldTileStorage& tiles, int index) {
+  apply(tiles, { PendingEvent::TileChanged, index });
+}
+
+void TileSystemRegistry::ChunkLoaded(const WorldTileStorage& tiles, int chunk) {
+  apply(tiles, { PendingEvent::ChunkLoaded, chunk });
+}
+
+void TileSystemRegistry::ChunkUnloaded(const WorldTileStorage& tiles, int chunk) {
+  apply(tiles, { PendingEvent::ChunkUnloaded, chunk });
+}
+
+void TileSystemRegistry::Run(GameWorld& world, const WorldTileStorage& tiles) {
+  running = true;
+  for (Entry& entry : entries) {
+    if (!entry.tiles.empty()) entry.system->Update(world, entry.tiles);
+  }
+  running = false;
+
+  // Replaying may page chunks in and queue more events, so walk by index
+  for (size_t i = 0; i < pendingEvents.size(); ++i) {
+    PendingEvent event = pendingEvents[i];
+    apply(tiles, event);
+  }
+  pendingEvents.clear();
+}
+
+int TileSystemRegistry::SystemCount() const {
+  return static_cast<int>(entries.size());
+}
+
+const TileSystem& TileSystemRegistry::System(int system) const {
+  if (system < 0 || system >= SystemCount()) {
+    throw GameError("Unknown tile system " + std::to_string(system));
+  }
+  return *entries[system].system;
+}
+
+int TileSystemRegistry::ActiveCount(int system) const {
+  System(system);
+  return static_cast<int>(entries[system].tiles.size());
+}
+
+void TileSystemRegistry::apply(const WorldTileStorage& tiles, const PendingEvent& event) {
+  if (running) {
+    pendingEvents.push_back(event);
+    return;
+  }
+
+  for (Entry& entry : entries) {
+    switch (event.kind) {
+      case PendingEvent::TileChanged:
+        refresh(entry, tiles, event.value);
+        break;
+      case PendingEvent::ChunkLoaded:
+        // A replayed load may refer to a chunk that was evicted again since
+        if (tiles.IsChunkResident(event.value)) {
+          scanChunk(entry, tiles, event.value);
+        }
+        break;
+      case PendingEvent::ChunkUnloaded: {
+        TileRange range = tiles.ChunkTiles(event.value);
+        for (int y = range.minY; y < range.maxY; ++y) {
+          for (int x = range.minX; x < range.maxX; ++x) {
+            remove(entry, y * tiles.Width() + x);
+          }
+        }
+        break;
+      }
+    }
+  }
+}
+
+void TileSystemRegistry::scanChunk(Entry& entry, const WorldTileStorage& tiles, int chunk) {
+  uint8_t required = entry.system->RequiredFlags();
+  TileRange range = tiles.ChunkTiles(chunk);
+  for (int y = range.minY; y < range.maxY; ++y) {
+    for (int x = range.minX; x < range.maxX; ++x) {
+      int index = y * tiles.Width() + x;
+      if ((tiles.Flags(index) & required) != required) continue;
+      if (!entry.system->Wants(WorldTileView(tiles, index))) continue;
+      add(entry, index);
+    }
+  }
+}
+
+void TileSystemRegistry::refresh(Entry& entry, const WorldTileStorage& tiles, int index) {
+  // Reading an evicted tile would page its chunk back in just to drop it again
+  if (!tiles.IsResident(index)) {
+    remove(entry, index);
+    return;
+  }
+
+  uint8_t required = entry.system->RequiredFlags();
+  bool wants = (tiles.Flags(index) & required) == required && entry.system->Wants(WorldTileView(tiles, index));
+  if (wants) {
+    add(entry, index);
+  } else {
+    remove(entry, index);
+  }
+}
+
+void TileSystemRegistry::add(Entry& entry, int index) {
+  if (entry.positions.count(index)) return;
+  entry.positions.emplace(index, entry.tiles.size());
+  entry.tiles.push_back(index);
+}
+
+void TileSystemRegistry::remove(Entry& entry, int index) {
+  auto it = entry.positions.find(index);
+  if (it == entry.positions.end()) return;
+
+  size_t position = it->second;
+  int last = entry.tiles.back();
+  entry.tiles[position] = last;
+  entry.positions[last] = position;
+  entry.tiles.pop_back();
+  entry.positions.erase(index);
+}
+
+TileSystemRegistry::~TileSystemRegistry() = default;
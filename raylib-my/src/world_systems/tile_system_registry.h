@@ -0,0 +1,53 @@
+#pragma once
+
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "tile_system.h"
+
+// Forward declarations
+class GameWorld;
+class WorldTileStorage;
+
+// Owns the world's tile systems and one active set per system: a dense list of
+// tile indices for iteration plus a position map for O(1) swap-removal. Only
+// resident tiles are active, so systems pause in chunks a paged world has evicted.
+class TileSystemRegistry {
+public:
+  TileSystemRegistry();
+  // Scans the resident chunks once to seed the system's active set
+  void Register(std::unique_ptr<TileSystem>, const WorldTileStorage&);
+  void TileChanged(const WorldTileStorage&, int index);
+  void ChunkLoaded(const WorldTileStorage&, int chunk);
+  void ChunkUnloaded(const WorldTileStorage&, int chunk);
+  void Run(GameWorld&, const WorldTileStorage&);
+  int SystemCount() const;
+  const TileSystem& System(int) const;
+  int ActiveCount(int system) const;
+  ~TileSystemRegistry();
+
+private:
+  struct Entry {
+    std::unique_ptr<TileSystem> system;
+    std::vector<int> tiles;
+    std::unordered_map<int, size_t> positions;
+  };
+
+  // Systems iterate their active lists by reference, so changes that arrive while
+  // they run are replayed in order afterwards
+  struct PendingEvent {
+    enum Kind { TileChanged, ChunkLoaded, ChunkUnloaded } kind;
+    int value;
+  };
+
+  std::vector<Entry> entries;
+  bool running;
+  std::vector<PendingEvent> pendingEvents;
+
+  void apply(const WorldTileStorage&, const PendingEvent&);
+  void scanChunk(Entry&, const WorldTileStorage&, int chunk);
+  void refresh(Entry&, const WorldTileStorage&, int index);
+  void add(Entry&, int index);
+  void remove(Entry&, int index);
+};
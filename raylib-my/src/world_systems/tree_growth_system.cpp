@@ -0,0 +1,41 @@
+#include "tree_growth_system.h"
+
+#include "../common/game_error.h"
+#include "../game_world.h"
+#include "../world_tiles/tile_storage.h"
+#include "../world_tiles/tile_view.h"
+#include "../world_tiles/decorations/decoration.h"
+
+TreeGrowthSystem::TreeGrowthSystem(const WorldTileDecoration& tree_, int ticks):
+  tree { tree_ },
+  ticksPerStage { ticks },
+  tick { 0 }
+{
+  if (ticksPerStage <= 0) {
+    throw GameError("Tree growth needs a positive number of ticks per stage");
+  }
+}
+
+const char* TreeGrowthSystem::Name() const {
+  return "TreeGrowth";
+}
+
+uint8_t TreeGrowthSystem::RequiredFlags() const {
+  return WorldTileStorage::HasDecoration;
+}
+
+bool TreeGrowthSystem::Wants(const WorldTileView& tile) const {
+  return tile.Decoration() == tree.Type && tile.DecorationState() < MaxStage;
+}
+
+void TreeGrowthSystem::Update(GameWorld& world, const std::vector<int>& activeTiles) {
+  ++tick;
+  uint32_t period = static_cast<uint32_t>(ticksPerStage);
+  for (int index : activeTiles) {
+    if ((static_cast<uint32_t>(index) + tick) % period != 0) continue;
+    WorldTileView tile = world.GetTile(index);
+    world.SetTileDecoration(tile.X(), tile.Y(), &tree, tile.DecorationState() + 1);
+  }
+}
+
+TreeGrowthSystem::~TreeGrowthSystem() {}
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <cstdint>
+
+#include "tile_system.h"
+
+// Forward declaration
+class WorldTileDecoration;
+
+// Grows trees through MaxStage stages kept in the decoration state. Every tree is
+// visited each tick but advances once per ticksPerStage, staggered by tile index so
+// the resulting dirty tiles spread over frames; fully grown trees leave the set.
+class TreeGrowthSystem: public TileSystem {
+public:
+  static constexpr uint32_t MaxStage = 3;
+
+  TreeGrowthSystem(const WorldTileDecoration& tree, int ticksPerStage);
+  const char* Name() const override;
+  uint8_t RequiredFlags() const override;
+  bool Wants(const WorldTileView&) const override;
+  void Update(GameWorld&, const std::vector<int>& activeTiles) override;
+  ~TreeGrowthSystem() override;
+
+private:
+  const WorldTileDecoration& tree;
+  int ticksPerStage;
+  uint32_t tick;
+};
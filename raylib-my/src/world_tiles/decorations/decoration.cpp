@@ -1,11 +1,13 @@
 #include "decoration.h"
 
+#include <utility>
+
 WorldTileDecoration::WorldTileDecoration(WorldDecorationType type, std::string name):
-  Type { type },
-  Name { name }
+  Name { std::move(name) },
+  Type { type }
 {}
 
-int WorldTileDecoration::MoveSpeed() {
+int WorldTileDecoration::MoveSpeed() const {
   return 1;
 }
 
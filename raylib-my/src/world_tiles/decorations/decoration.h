@@ -4,12 +4,14 @@
 
 enum class WorldDecorationType { Grass, Rock, Wall, Tree, Road };
 
+// Immutable type record shared by every tile with this decoration; per-tile
+// state lives in the world's tile storage
 class WorldTileDecoration {
 public:
-  std::string Name;
-  WorldDecorationType Type;
+  const std::string Name;
+  const WorldDecorationType Type;
 
   WorldTileDecoration(WorldDecorationType, std::string);
-  int MoveSpeed();
+  int MoveSpeed() const;
   ~WorldTileDecoration();
 };
@@ -5,16 +5,13 @@
 
 enum class ResourceType { Coil, Clay, Iron, Copper };
 
+// Immutable type record shared by every deposit of this resource; volumes are
+// per tile and live in the world's tile storage
 class WorldTileResource {
 public:
-  std::string Name;
-  ResourceType Type;
+  const std::string Name;
+  const ResourceType Type;
 
-  WorldTileResource(ResourceType, std::string, uint32_t);
-  uint32_t Volume();
+  WorldTileResource(ResourceType, std::string);
   ~WorldTileResource();
-
-private:
-  uint32_t volume;
-  uint32_t initialVolume;
 };
@@ -0,0 +1,492 @@
+#include "tile_storage.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <string>
+
+#include "../common/game_error.h"
+
+namespace {
+
+// The four byte columns and three overlay state words per tile
+constexpr size_t recordBytesPerTile = 4 + 3 * sizeof(uint32_t);
+
+}
+
+WorldTileStorage::WorldTileStorage(int w, int h, WorldArena& arena, const WorldPagingOptions& options):
+  width { w },
+  height { h },
+  chunkShift { 0 },
+  chunkTiles { 0 },
+  chunksPerRow { 0 },
+  pageBytes { 0 },
+  paged { options.enabled },
+  budgetPages { 0 },
+  pageFileName { options.pageFile },
+  pages { },
+  residentChunks { },
+  spareBuffers { },
+  terrainPalette { },
+  overlayPool { },
+  freeOverlays { },
+  pageFile { },
+  recordBuffer { },
+  stats { },
+  frame { 1 },
+  source { },
+  onLoaded { },
+  onEvicting { }
+{
+  int size = options.chunkSize;
+  if (size <= 0 || (size & (size - 1)) != 0) {
+    throw GameError("Tile chunk size must be a power of two, got " + std::to_string(size));
+  }
+  while ((1 << chunkShift) < size) ++chunkShift;
+
+  chunkTiles = size * size;
+  chunksPerRow = (w + size - 1) / size;
+  int chunkRows = (h + size - 1) / size;
+  pageBytes = static_cast<size_t>(chunkTiles) * BytesPerTile;
+  pages = std::vector<Page>(static_cast<size_t>(chunksPerRow) * chunkRows);
+
+  if (paged) {
+    budgetPages = static_cast<int>(std::max<size_t>(1, options.budgetBytes / pageBytes));
+    recordBuffer.resize(static_cast<size_t>(chunkTiles) * recordBytesPerTile);
+    openPageFile();
+  } else {
+    // Every page is resident for the world's lifetime, so they share one arena block
+    size_t total = pageBytes * pages.size();
+    std::byte* block = static_cast<std::byte*>(arena.Allocate(total, alignof(uint32_t)));
+    std::memset(block, 0, total);
+    residentChunks.reserve(pages.size());
+    for (size_t chunk = 0; chunk < pages.size(); ++chunk) {
+      pages[chunk].data = block + chunk * pageBytes;
+      pages[chunk].residentSlot = static_cast<int>(chunk);
+      residentChunks.push_back(static_cast<int>(chunk));
+    }
+    budgetPages = static_cast<int>(pages.size());
+  }
+
+  stats.chunkSize = size;
+  stats.chunks = static_cast<int>(pages.size());
+  stats.budgetPages = budgetPages;
+  stats.pageBytes = pageBytes;
+  stats.residentPages = static_cast<int>(residentChunks.size());
+  stats.peakResidentPages = stats.residentPages;
+}
+
+void WorldTileStorage::openPageFile() {
+  if (pageFileName.empty()) {
+    throw GameError("Paged tile storage needs a page file");
+  }
+  // Pages only have to survive this session, so the file starts empty every time
+  pageFile.open(pageFileName, std::ios::in | std::ios::out | std::ios::binary | std::ios::trunc);
+  if (!pageFile.is_open()) {
+    throw GameError("Cannot open page file " + pageFileName);
+  }
+}
+
+int WorldTileStorage::Width() const {
+  return width;
+}
+
+int WorldTileStorage::Height() const {
+  return height;
+}
+
+int WorldTileStorage::Size() const {
+  return width * height;
+}
+
+int WorldTileStorage::OverlayCount() const {
+  return static_cast<int>(overlayPool.size() - freeOverlays.size());
+}
+
+size_t WorldTileStorage::ByteSize() const {
+  return (residentChunks.size() + spareBuffers.size()) * pageBytes
+    + pages.size() * sizeof(Page)
+    + overlayPool.size() * sizeof(OverlayState)
+    + freeOverlays.size() * sizeof(uint32_t)
+    + terrainPalette.size() * sizeof(const WorldTileTerrainType*);
+}
+
+std::byte* WorldTileStorage::page(int index, int& offset) const {
+  int y = index / width;
+  int x = index - y * width;
+  int mask = (1 << chunkShift) - 1;
+  int chunk = (y >> chunkShift) * chunksPerRow + (x >> chunkShift);
+  offset = ((y & mask) << chunkShift) | (x & mask);
+
+  Page& entry = pages[chunk];
+  if (paged) {
+    if (!entry.data) pageIn(chunk);
+    entry.lastUsed = frame;
+  }
+  return entry.data;
+}
+
+uint8_t& WorldTileStorage::byteAt(int index, Column column) const {
+  int offset;
+  std::byte* data = page(index, offset);
+  uint8_t* bytes = reinterpret_cast<uint8_t*>(data + chunkTiles * sizeof(uint32_t));
+  return bytes[column * chunkTiles + offset];
+}
+
+uint32_t& WorldTileStorage::overlayAt(int index) const {
+  int offset;
+  std::byte* data = page(index, offset);
+  return reinterpret_cast<uint32_t*>(data)[offset];
+}
+
+uint8_t& WorldTileStorage::writeByte(int index, Column column) {
+  uint8_t& value = byteAt(index, column);
+  if (paged) pages[ChunkOf(index)].modified = true;
+  return value;
+}
+
+uint32_t& WorldTileStorage::writeOverlay(int index) {
+  uint32_t& value = overlayAt(index);
+  if (paged) pages[ChunkOf(index)].modified = true;
+  return value;
+}
+
+const WorldTileTerrainType& WorldTileStorage::Terrain(int index) const {
+  return *terrainPalette[byteAt(index, TerrainColumn)];
+}
+
+WorldTileStorage::TerrainId WorldTileStorage::TerrainIdAt(int index) const {
+  return byteAt(index, TerrainColumn);
+}
+
+const WorldTileTerrainType& WorldTileStorage::TerrainById(TerrainId id) const {
+  if (id >= terrainPalette.size()) {
+    throw GameError("Unknown terrain id " + std::to_string(id));
+  }
+  return *terrainPalette[id];
+}
+
+uint8_t WorldTileStorage::Flags(int index) const {
+  return byteAt(index, FlagsColumn);
+}
+
+bool WorldTileStorage::HasOverlay(int index) const {
+  return (Flags(index) & (HasDecoration | HasResource)) != 0;
+}
+
+WorldDecorationType WorldTileStorage::Decoration(int index) const {
+  return static_cast<WorldDecorationType>(byteAt(index, DecorationColumn));
+}
+
+ResourceType WorldTileStorage::Resource(int index) const {
+  return static_cast<ResourceType>(byteAt(index, ResourceColumn));
+}
+
+const WorldTileStorage::OverlayState& WorldTileStorage::Overlay(int index) const {
+  static const OverlayState bare { };
+  uint32_t slot = overlayAt(index);
+  return slot == noOverlay ? bare : overlayPool[slot - 1];
+}
+
+void WorldTileStorage::SetTerrain(int index, const WorldTileTerrainType& type) {
+  TerrainId id = internTerrain(type);
+  writeByte(index, TerrainColumn) = id;
+}
+
+void WorldTileStorage::SetDecoration(int index, WorldDecorationType type, uint32_t state) {
+  writeByte(index, DecorationColumn) = static_cast<uint8_t>(type);
+  writeByte(index, FlagsColumn) |= HasDecoration;
+  acquireOverlay(writeOverlay(index)).decorationState = state;
+}
+
+void WorldTileStorage::ClearDecoration(int index) {
+  if (!(Flags(index) & HasDecoration)) return;
+  writeByte(index, DecorationColumn) = 0;
+  writeByte(index, FlagsColumn) &= ~HasDecoration;
+  overlayPool[overlayAt(index) - 1].decorationState = 0;
+  releaseOverlayIfBare(index);
+}
+
+void WorldTileStorage::SetResource(int index, ResourceType type, uint32_t vol) {
+  writeByte(index, ResourceColumn) = static_cast<uint8_t>(type);
+  writeByte(index, FlagsColumn) |= HasResource;
+  OverlayState& state = acquireOverlay(writeOverlay(index));
+  state.volume = vol;
+  state.initialVolume = vol;
+}
+
+void WorldTileStorage::SetResourceVolume(int index, uint32_t vol) {
+  if (!(Flags(index) & HasResource)) {
+    throw GameError("Cannot set resource volume on a tile without a resource");
+  }
+  overlayPool[writeOverlay(index) - 1].volume = vol;
+}
+
+void WorldTileStorage::ClearResource(int index) {
+  if (!(Flags(index) & HasResource)) return;
+  writeByte(index, ResourceColumn) = 0;
+  writeByte(index, FlagsColumn) &= ~HasResource;
+  OverlayState& state = overlayPool[overlayAt(index) - 1];
+  state.volume = 0;
+  state.initialVolume = 0;
+  releaseOverlayIfBare(index);
+}
+
+bool WorldTileStorage::IsPaged() const {
+  return paged;
+}
+
+int WorldTileStorage::ChunkSize() const {
+  return 1 << chunkShift;
+}
+
+int WorldTileStorage::ChunkCount() const {
+  return static_cast<int>(pages.size());
+}
+
+int WorldTileStorage::ChunkOf(int index) const {
+  int y = index / width;
+  int x = index - y * width;
+  return (y >> chunkShift) * chunksPerRow + (x >> chunkShift);
+}
+
+TileRange WorldTileStorage::ChunkTiles(int chunk) const {
+  int minX = (chunk % chunksPerRow) << chunkShift;
+  int minY = (chunk / chunksPerRow) << chunkShift;
+  return { minX, minY, std::min(minX + ChunkSize(), width), std::min(minY + ChunkSize(), height) };
+}
+
+bool WorldTileStorage::IsResident(int index) const {
+  return IsChunkResident(ChunkOf(index));
+}
+
+bool WorldTileStorage::IsChunkResident(int chunk) const {
+  return pages[chunk].data != nullptr;
+}
+
+const std::vector<int>& WorldTileStorage::ResidentChunks() const {
+  return residentChunks;
+}
+
+void WorldTileStorage::SetTileSource(TileSource tileSource) {
+  if (!paged) {
+    throw GameError("Only paged tile storage reads from a tile source");
+  }
+  source = std::move(tileSource);
+}
+
+void WorldTileStorage::SetPageListeners(ChunkListener loaded, ChunkListener evicting) {
+  onLoaded = std::move(loaded);
+  onEvicting = std::move(evicting);
+}
+
+void WorldTileStorage::BeginFrame() {
+  ++frame;
+}
+
+WorldPagingStats WorldTileStorage::PagingStats() const {
+  WorldPagingStats current = stats;
+  current.residentPages = static_cast<int>(residentChunks.size());
+  return current;
+}
+
+void WorldTileStorage::pageIn(int chunk) const {
+  Page& entry = pages[chunk];
+  if (!entry.stored && !source) {
+    throw GameError("Paged tile storage has no tile source for chunk " + std::to_string(chunk));
+  }
+
+  while (static_cast<int>(residentChunks.size()) >= budgetPages) {
+    if (!evictOne()) break;
+  }
+
+  if (!spareBuffers.empty()) {
+    entry.buffer = std::move(spareBuffers.back());
+    spareBuffers.pop_back();
+  } else {
+    entry.buffer = std::make_unique<std::byte[]>(pageBytes);
+  }
+  entry.data = entry.buffer.get();
+  std::memset(entry.data, 0, pageBytes);
+  entry.lastUsed = frame;
+  entry.modified = false;
+  entry.residentSlot = static_cast<int>(residentChunks.size());
+  residentChunks.push_back(chunk);
+
+  if (entry.stored) {
+    readRecord(chunk, entry.data);
+    ++stats.pageInsFromFile;
+  } else {
+    buildFromSource(chunk, entry.data);
+  }
+
+  ++stats.pageIns;
+  stats.peakResidentPages = std::max(stats.peakResidentPages, static_cast<int>(residentChunks.size()));
+  if (onLoaded) onLoaded(chunk);
+}
+
+// Least recently used page that the current frame has not touched. When every
+// resident page is in use the budget is exceeded until the next frame rather
+// than evicting tiles that are still being drawn or updated.
+bool WorldTileStorage::evictOne() const {
+  int victim = -1;
+  for (int chunk : residentChunks) {
+    if (pages[chunk].lastUsed >= frame) continue;
+    if (victim < 0 || pages[chunk].lastUsed < pages[victim].lastUsed) victim = chunk;
+  }
+  if (victim < 0) return false;
+
+  if (onEvicting) onEvicting(victim);
+
+  Page& entry = pages[victim];
+  if (entry.modified) writeBack(victim);
+
+  const uint32_t* overlay = reinterpret_cast<const uint32_t*>(entry.data);
+  for (int offset = 0; offset < chunkTiles; ++offset) {
+    if (overlay[offset] != noOverlay) freeOverlays.push_back(overlay[offset] - 1);
+  }
+
+  if (static_cast<int>(residentChunks.size() + spareBuffers.size()) <= budgetPages) {
+    spareBuffers.push_back(std::move(entry.buffer));
+  } else {
+    entry.buffer.reset();
+  }
+  entry.data = nullptr;
+  entry.modified = false;
+
+  int last = residentChunks.back();
+  residentChunks[entry.residentSlot] = last;
+  pages[last].residentSlot = entry.residentSlot;
+  residentChunks.pop_back();
+  entry.residentSlot = -1;
+
+  ++stats.evictions;
+  return true;
+}
+
+void WorldTileStorage::writeBack(int chunk) const {
+  Page& entry = pages[chunk];
+  const uint32_t* overlay = reinterpret_cast<const uint32_t*>(entry.data);
+  std::byte* record = recordBuffer.data();
+  std::memcpy(record, entry.data + chunkTiles * sizeof(uint32_t), 4 * static_cast<size_t>(chunkTiles));
+
+  uint32_t* volumes = reinterpret_cast<uint32_t*>(record + 4 * chunkTiles);
+  uint32_t* initialVolumes = volumes + chunkTiles;
+  uint32_t* decorationStates = initialVolumes + chunkTiles;
+  for (int offset = 0; offset < chunkTiles; ++offset) {
+    OverlayState state = overlay[offset] == noOverlay ? OverlayState { } : overlayPool[overlay[offset] - 1];
+    volumes[offset] = state.volume;
+    initialVolumes[offset] = state.initialVolume;
+    decorationStates[offset] = state.decorationState;
+  }
+
+  pageFile.seekp(static_cast<std::streamoff>(chunk) * static_cast<std::streamoff>(recordBuffer.size()));
+  pageFile.write(reinterpret_cast<const char*>(record), static_cast<std::streamsize>(recordBuffer.size()));
+  if (!pageFile) {
+    throw GameError("Failed to write tile page " + std::to_string(chunk) + " to " + pageFileName);
+  }
+  entry.stored = true;
+  ++stats.writeBacks;
+}
+
+void WorldTileStorage::readRecord(int chunk, std::byte* data) const {
+  std::byte* record = recordBuffer.data();
+  pageFile.seekg(static_cast<std::streamoff>(chunk) * static_cast<std::streamoff>(recordBuffer.size()));
+  pageFile.read(reinterpret_cast<char*>(record), static_cast<std::streamsize>(recordBuffer.size()));
+  if (!pageFile) {
+    throw GameError("Failed to read tile page " + std::to_string(chunk) + " from " + pageFileName);
+  }
+
+  uint8_t* bytes = reinterpret_cast<uint8_t*>(data + chunkTiles * sizeof(uint32_t));
+  std::memcpy(bytes, record, 4 * static_cast<size_t>(chunkTiles));
+
+  uint32_t* overlay = reinterpret_cast<uint32_t*>(data);
+  const uint32_t* volumes = reinterpret_cast<const uint32_t*>(record + 4 * chunkTiles);
+  const uint32_t* initialVolumes = volumes + chunkTiles;
+  const uint32_t* decorationStates = initialVolumes + chunkTiles;
+  const uint8_t* flags = bytes + FlagsColumn * chunkTiles;
+  for (int offset = 0; offset < chunkTiles; ++offset) {
+    if (!(flags[offset] & (HasDecoration | HasResource))) continue;
+    OverlayState& state = acquireOverlay(overlay[offset]);
+    state.volume = volumes[offset];
+    state.initialVolume = initialVolumes[offset];
+    state.decorationState = decorationStates[offset];
+  }
+}
+
+void WorldTileStorage::buildFromSource(int chunk, std::byte* data) const {
+  uint32_t* overlay = reinterpret_cast<uint32_t*>(data);
+  uint8_t* bytes = reinterpret_cast<uint8_t*>(data + chunkTiles * sizeof(uint32_t));
+  TileRange range = ChunkTiles(chunk);
+
+  for (int y = range.minY; y < range.maxY; ++y) {
+    for (int x = range.minX; x < range.maxX; ++x) {
+      WorldTileInit tile = source(x, y);
+      if (!tile.terrain) {
+        throw GameError("Tile source returned no terrain for x: " + std::to_string(x) + ", y: " + std::to_string(y));
+      }
+
+      int offset = ((y - range.minY) << chunkShift) + (x - range.minX);
+      bytes[TerrainColumn * chunkTiles + offset] = internTerrain(*tile.terrain);
+      if (tile.decoration) {
+        bytes[DecorationColumn * chunkTiles + offset] = static_cast<uint8_t>(tile.decoration->Type);
+        bytes[FlagsColumn * chunkTiles + offset] |= HasDecoration;
+        acquireOverlay(overlay[offset]).decorationState = tile.decorationState;
+      }
+      if (tile.resource) {
+        bytes[ResourceColumn * chunkTiles + offset] = static_cast<uint8_t>(tile.resource->Type);
+        bytes[FlagsColumn * chunkTiles + offset] |= HasResource;
+        OverlayState& state = acquireOverlay(overlay[offset]);
+        state.volume = tile.resourceVolume;
+        state.initialVolume = tile.resourceVolume;
+      }
+    }
+  }
+}
+
+WorldTileStorage::OverlayState& WorldTileStorage::acquireOverlay(uint32_t& slotRef) const {
+  if (slotRef != noOverlay) {
+    return overlayPool[slotRef - 1];
+  }
+
+  uint32_t slot;
+  if (!freeOverlays.empty()) {
+    slot = freeOverlays.back();
+    freeOverlays.pop_back();
+    overlayPool[slot] = OverlayState { };
+  } else {
+    slot = static_cast<uint32_t>(overlayPool.size());
+    overlayPool.emplace_back();
+  }
+  slotRef = slot + 1;
+  return overlayPool[slot];
+}
+
+void WorldTileStorage::releaseOverlayIfBare(int index) {
+  uint32_t& slot = writeOverlay(index);
+  if (HasOverlay(index) || slot == noOverlay) return;
+  freeOverlays.push_back(slot - 1);
+  slot = noOverlay;
+}
+
+// Worlds use a handful of terrain types, so a linear probe beats hashing here
+WorldTileStorage::TerrainId WorldTileStorage::internTerrain(const WorldTileTerrainType& type) const {
+  auto it = std::find(terrainPalette.begin(), terrainPalette.end(), &type);
+  if (it != terrainPalette.end()) {
+    return static_cast<TerrainId>(it - terrainPalette.begin());
+  }
+  if (terrainPalette.size() > std::numeric_limits<TerrainId>::max()) {
+    throw GameError("Too many terrain types in one world");
+  }
+  terrainPalette.push_back(&type);
+  return static_cast<TerrainId>(terrainPalette.size() - 1);
+}
+
+// The page file is scratch space for this session only
+WorldTileStorage::~WorldTileStorage() {
+  if (pageFile.is_open()) {
+    pageFile.close();
+    std::remove(pageFileName.c_str());
+  }
+}
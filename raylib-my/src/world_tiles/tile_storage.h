@@ -0,0 +1,175 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "../common/tile_range.h"
+#include "../common/world_arena.h"
+#include "../common/world_paging_stats.h"
+#include "tile_terrain_type.h"
+#include "decorations/decoration.h"
+#include "resources/resource.h"
+
+// One tile as produced by world loaders; GameWorld flattens it into the columns.
+// Decoration and resource point at the shared type records in TilesManager.
+struct WorldTileInit {
+  const WorldTileTerrainType* terrain = nullptr;
+  const WorldTileDecoration* decoration = nullptr;
+  uint32_t decorationState = 0;
+  const WorldTileResource* resource = nullptr;
+  uint32_t resourceVolume = 0;
+};
+
+struct WorldPagingOptions {
+  bool enabled = false;
+  // Power of two; also the chunk size of unpaged storage
+  int chunkSize = 64;
+  size_t budgetBytes = 0;
+  std::string pageFile;
+};
+
+// Tiles stored column by column: one small value per property in dense arrays,
+// so a tile costs BytesPerTile bytes and a scan over one property touches only
+// that column. Terrain types are interned into a per-world palette of at most
+// 256 entries. Per-instance overlay state (volumes, decoration state) lives in a
+// pool with one slot per decorated or resourced tile, so bare tiles pay nothing for it.
+//
+// The columns are cut into square chunks, each a page of its own. Normally every
+// page comes from the world's arena and stays put. With paging enabled only the
+// most recently used pages are in memory: a missing page is read back from the
+// page file if it was ever written, otherwise rebuilt from the tile source, and
+// the least recently used page is evicted once the budget is full, written back
+// first if it was modified.
+class WorldTileStorage {
+public:
+  using TerrainId = uint8_t;
+  // Random-access tile source that pages are rebuilt from until first written back
+  using TileSource = std::function<WorldTileInit(int x, int y)>;
+  using ChunkListener = std::function<void(int chunk)>;
+
+  enum Flag : uint8_t {
+    HasDecoration = 1 << 0,
+    HasResource = 1 << 1
+  };
+
+  struct OverlayState {
+    uint32_t volume = 0;
+    uint32_t initialVolume = 0;
+    uint32_t decorationState = 0;
+  };
+
+  static constexpr size_t BytesPerTile =
+    sizeof(TerrainId) + sizeof(uint8_t) + sizeof(uint8_t) + sizeof(uint8_t) + sizeof(uint32_t);
+
+  WorldTileStorage(int width, int height, WorldArena&, const WorldPagingOptions& = WorldPagingOptions());
+  WorldTileStorage(const WorldTileStorage&) = delete;
+  WorldTileStorage& operator=(const WorldTileStorage&) = delete;
+
+  int Width() const;
+  int Height() const;
+  int Size() const;
+  int OverlayCount() const;
+  size_t ByteSize() const;
+
+  const WorldTileTerrainType& Terrain(int index) const;
+  TerrainId TerrainIdAt(int index) const;
+  const WorldTileTerrainType& TerrainById(TerrainId) const;
+  uint8_t Flags(int index) const;
+  bool HasOverlay(int index) const;
+  WorldDecorationType Decoration(int index) const;
+  ResourceType Resource(int index) const;
+  // Zeroed state for tiles without an overlay
+  const OverlayState& Overlay(int index) const;
+
+  void SetTerrain(int index, const WorldTileTerrainType&);
+  void SetDecoration(int index, WorldDecorationType, uint32_t state);
+  void ClearDecoration(int index);
+  // Starts a fresh deposit: the initial volume is reset to the given volume
+  void SetResource(int index, ResourceType, uint32_t volume);
+  void SetResourceVolume(int index, uint32_t volume);
+  void ClearResource(int index);
+
+  bool IsPaged() const;
+  int ChunkSize() const;
+  int ChunkCount() const;
+  int ChunkOf(int index) const;
+  TileRange ChunkTiles(int chunk) const;
+  bool IsResident(int index) const;
+  bool IsChunkResident(int chunk) const;
+  // Chunks currently in memory, in no particular order; every chunk when unpaged
+  const std::vector<int>& ResidentChunks() const;
+  // Paged storage only
+  void SetTileSource(TileSource);
+  // Called after a page is loaded and before one is evicted; must not read evicted tiles
+  void SetPageListeners(ChunkListener loaded, ChunkListener evicting);
+  // Pages used since the last call are never evicted, so a frame's working set stays put
+  void BeginFrame();
+  WorldPagingStats PagingStats() const;
+  ~WorldTileStorage();
+
+private:
+  static constexpr uint32_t noOverlay = 0;
+
+  // Layout of one page of N tiles: overlay slots (4N), then terrain, decoration,
+  // resource and flags (N each). The page file record keeps the four byte columns
+  // followed by volume, initial volume and decoration state (4N each).
+  enum Column { TerrainColumn, DecorationColumn, ResourceColumn, FlagsColumn };
+
+  struct Page {
+    std::byte* data = nullptr;
+    std::unique_ptr<std::byte[]> buffer;
+    uint64_t lastUsed = 0;
+    int residentSlot = -1;
+    bool modified = false;
+    bool stored = false;
+  };
+
+  int width;
+  int height;
+  int chunkShift;
+  int chunkTiles;
+  int chunksPerRow;
+  size_t pageBytes;
+  bool paged;
+  int budgetPages;
+  std::string pageFileName;
+
+  // Reads page chunks in and out of memory, so everything paging touches is
+  // mutable; paged storage is for the game thread only
+  mutable std::vector<Page> pages;
+  mutable std::vector<int> residentChunks;
+  mutable std::vector<std::unique_ptr<std::byte[]>> spareBuffers;
+  mutable std::vector<const WorldTileTerrainType*> terrainPalette;
+  mutable std::vector<OverlayState> overlayPool;
+  mutable std::vector<uint32_t> freeOverlays;
+  mutable std::fstream pageFile;
+  mutable std::vector<std::byte> recordBuffer;
+  mutable WorldPagingStats stats;
+  uint64_t frame;
+  TileSource source;
+  ChunkListener onLoaded;
+  ChunkListener onEvicting;
+
+  std::byte* page(int index, int& offset) const;
+  uint8_t& byteAt(int index, Column) const;
+  uint32_t& overlayAt(int index) const;
+  // Same as above but marks the page modified
+  uint8_t& writeByte(int index, Column);
+  uint32_t& writeOverlay(int index);
+
+  void pageIn(int chunk) const;
+  bool evictOne() const;
+  void writeBack(int chunk) const;
+  void readRecord(int chunk, std::byte* data) const;
+  void buildFromSource(int chunk, std::byte* data) const;
+  void openPageFile();
+
+  TerrainId internTerrain(const WorldTileTerrainType&) const;
+  OverlayState& acquireOverlay(uint32_t& slot) const;
+  void releaseOverlayIfBare(int index);
+};
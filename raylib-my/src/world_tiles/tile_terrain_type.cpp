@@ -1,4 +1,6 @@
 #include "tile_terrain_type.h"
+#include "../common/color_2d.h"
+#include "../graphics/image_cache.h"
 #include "../graphics/resources_system.h"
 
 #include <iostream>
@@ -9,22 +11,23 @@ WorldTileTerrainType::WorldTileTerrainType(std::string nm, float spd, bool wtr,
   texurePath { txr },
   isWater { wtr },
   initialized { false },
-  textureSrcRect { srcRect }
+  textureSrcRect { srcRect },
+  atlasRect { 0, 0, 0, 0 },
+  minimapColor { Color2D::Magenta() }
 {}
 
 bool WorldTileTerrainType::emptyTextureSrcRect() {
   return (textureSrcRect.width == 0) || (textureSrcRect.height == 0);
 }
 
-void WorldTileTerrainType::LoadTexture(ResourcesSystem& resources) {
-  ImageHandle fullImage = resources.LoadImage(texurePath.c_str());
-  if (!emptyTextureSrcRect()) {
-    Rectangle2D cropRect { textureSrcRect.x, textureSrcRect.y, textureSrcRect.width, textureSrcRect.height };
-    resources.ImageCrop(fullImage, cropRect);
+void WorldTileTerrainType::LoadTexture(ResourcesSystem& resources, ImageCache& sourceImages) {
+  ImageHandle source = sourceImages.Get(texurePath);
+  Rectangle2D cropRect = textureSrcRect;
+  if (emptyTextureSrcRect()) {
+    cropRect = { 0, 0, float(resources.GetImageWidth(source)), float(resources.GetImageHeight(source)) };
   }
-  textureObj = resources.LoadTextureFromImage(fullImage);
-  textureImage = resources.LoadImageFromTexture(textureObj);
-  resources.UnloadImage(fullImage);
+  textureImage = resources.ImageFromImage(source, cropRect);
+  textureObj = resources.LoadTextureFromImage(textureImage);
   initialized = true;
 }
 
@@ -32,6 +35,9 @@ TextureHandle WorldTileTerrainType::Texture() const {
   if (!initialized) {
     throw GameError("Texture for terran tile " + name + " is used but not loaded");
   }
+  if (!textureObj.IsValid()) {
+    throw GameError("Texture for terran tile " + name + " is not resident on the GPU");
+  }
   return textureObj;
 }
 
@@ -39,7 +45,74 @@ ImageHandle WorldTileTerrainType::TextureImage() const {
   if (!initialized) {
     throw GameError("Texture for terran tile " + name + " is used but not loaded");
   }
+  if (!textureImage.IsValid()) {
+    throw GameError("Image for terran tile " + name + " is not resident on the CPU");
+  }
   return textureImage;
 }
 
+void WorldTileTerrainType::ApplyResidency(ResourcesSystem& resources, Residency residency) {
+  if (!KeepsCpuCopy(residency) && textureImage.IsValid()) {
+    resources.UnloadImage(textureImage);
+    textureImage = ImageHandle();
+  }
+  if (!KeepsGpuCopy(residency) && textureObj.IsValid()) {
+    resources.UnloadTexture(textureObj);
+    textureObj = TextureHandle();
+  }
+}
+
+void WorldTileTerrainType::BuildSprites(ResourcesSystem& resources, float tileWidth, float tileHeight) {
+  ImageHandle source = TextureImage();
+  float width = static_cast<float>(resources.GetImageWidth(source));
+  float height = static_cast<float>(resources.GetImageHeight(source));
+  float halfWidth = tileWidth * 0.5f;
+  float halfHeight = tileHeight * 0.5f;
+  const Position2D corners[] = {
+    { halfWidth, 0.0f },
+    { tileWidth, halfHeight },
+    { halfWidth, tileHeight },
+    { 0.0f, halfHeight }
+  };
+
+  for (ImageHandle& sprite : sprites) {
+    resources.UnloadImage(sprite);
+  }
+
+  for (TileFrameStyle style : { TileFrameStyle::Plain, TileFrameStyle::Outlined }) {
+    ImageHandle sprite = resources.GenImageColor(tileWidth + 1.0f, tileHeight + 1.0f, Color2D(0, 0, 0, 0));
+    resources.ImageDraw(sprite, source, { 0, 0, width, height }, { 0, 0, tileWidth, tileHeight }, Color2D::White());
+    if (style == TileFrameStyle::Outlined) {
+      for (int i = 0; i < 4; ++i) {
+        resources.ImageDrawLineEx(sprite, corners[i], corners[(i + 1) % 4], 1.0f, Color2D::Black());
+      }
+    }
+    sprites[static_cast<int>(style)] = sprite;
+  }
+}
+
+ImageHandle WorldTileTerrainType::Sprite(TileFrameStyle style) const {
+  ImageHandle sprite = sprites[static_cast<int>(style)];
+  if (!sprite.IsValid()) {
+    throw GameError("Sprites for terran tile " + name + " are used but not built");
+  }
+  return sprite;
+}
+
+Rectangle2D WorldTileTerrainType::AtlasRect() const {
+  return atlasRect;
+}
+
+void WorldTileTerrainType::AssignAtlasRect(Rectangle2D rect) {
+  atlasRect = rect;
+}
+
+Color2D WorldTileTerrainType::MinimapColor() const {
+  return minimapColor;
+}
+
+void WorldTileTerrainType::AssignMinimapColor(Color2D color) {
+  minimapColor = color;
+}
+
 WorldTileTerrainType::~WorldTileTerrainType() {}
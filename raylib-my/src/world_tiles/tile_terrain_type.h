@@ -1,27 +1,42 @@
 #pragma once
 
+#include <array>
 #include <string>
 
+#include "../common/color_2d.h"
 #include "../common/game_error.h"
 #include "../common/position_2d.h"
 #include "../common/rectangle_2d.h"
 #include "../common/texture_handle.h"
 #include "../common/image_handle.h"
+#include "../common/residency.h"
 
 // Forward declaration
-class WorldTile;
 class ResourcesSystem;
+class ImageCache;
 
-class WorldTileTerrainType {
-  friend class WorldTile;
+enum class TileFrameStyle { Plain, Outlined };
 
+class WorldTileTerrainType {
 public:
   WorldTileTerrainType(std::string, float, bool, std::string, Rectangle2D);
-  WorldTile* NewTile(Position2D) const;
   ~WorldTileTerrainType();
-  void LoadTexture(ResourcesSystem& resources);
+  // Crops the terrain out of the cached source image and uploads it, keeping the CPU copy
+  void LoadTexture(ResourcesSystem& resources, ImageCache& sourceImages);
   TextureHandle Texture() const;
   ImageHandle TextureImage() const;
+  // Terrain scaled to the tile diamond with the frame already drawn, one per
+  // frame style, so rendering a tile is a single unscaled blit. Sprites are one
+  // pixel larger than the tile so the right and bottom frame corners fit.
+  void BuildSprites(ResourcesSystem& resources, float tileWidth, float tileHeight);
+  ImageHandle Sprite(TileFrameStyle style) const;
+  // Drops the terrain image or texture the policy does not keep; call once sprites
+  // and atlas are built. Texture()/TextureImage() throw for the dropped side.
+  void ApplyResidency(ResourcesSystem& resources, Residency residency);
+  Rectangle2D AtlasRect() const;
+  void AssignAtlasRect(Rectangle2D);
+  Color2D MinimapColor() const;
+  void AssignMinimapColor(Color2D);
   WorldTileTerrainType(const WorldTileTerrainType&) = delete;
   WorldTileTerrainType(WorldTileTerrainType&&) = delete;
   WorldTileTerrainType& operator=(const WorldTileTerrainType&) = delete;
@@ -35,6 +50,9 @@ private:
   Rectangle2D textureSrcRect;
   TextureHandle textureObj;
   ImageHandle textureImage;
+  std::array<ImageHandle, 2> sprites;
+  Rectangle2D atlasRect;
+  Color2D minimapColor;
   bool initialized;
 
   bool emptyTextureSrcRect();
@@ -0,0 +1,66 @@
+#include "tile_view.h"
+
+WorldTileView::WorldTileView(const WorldTileStorage& tiles, int idx):
+  storage { &tiles },
+  index { idx }
+{}
+
+int WorldTileView::Index() const {
+  return index;
+}
+
+int WorldTileView::X() const {
+  return index % storage->Width();
+}
+
+int WorldTileView::Y() const {
+  return index / storage->Width();
+}
+
+Position2D WorldTileView::Pos() const {
+  return { static_cast<float>(X()) + 0.5f, static_cast<float>(Y()) + 0.5f };
+}
+
+const WorldTileTerrainType& WorldTileView::TerrainType() const {
+  return storage->Terrain(index);
+}
+
+ImageHandle WorldTileView::Sprite(TileFrameStyle style) const {
+  return TerrainType().Sprite(style);
+}
+
+Rectangle2D WorldTileView::AtlasRect() const {
+  return TerrainType().AtlasRect();
+}
+
+Color2D WorldTileView::MinimapColor() const {
+  return TerrainType().MinimapColor();
+}
+
+bool WorldTileView::HasDecoration() const {
+  return (storage->Flags(index) & WorldTileStorage::HasDecoration) != 0;
+}
+
+WorldDecorationType WorldTileView::Decoration() const {
+  return storage->Decoration(index);
+}
+
+uint32_t WorldTileView::DecorationState() const {
+  return storage->Overlay(index).decorationState;
+}
+
+bool WorldTileView::HasResource() const {
+  return (storage->Flags(index) & WorldTileStorage::HasResource) != 0;
+}
+
+ResourceType WorldTileView::Resource() const {
+  return storage->Resource(index);
+}
+
+uint32_t WorldTileView::ResourceVolume() const {
+  return storage->Overlay(index).volume;
+}
+
+uint32_t WorldTileView::ResourceInitialVolume() const {
+  return storage->Overlay(index).initialVolume;
+}
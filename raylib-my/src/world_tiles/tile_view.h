@@ -0,0 +1,37 @@
+#pragma once
+
+#include <cstdint>
+
+#include "../common/color_2d.h"
+#include "../common/image_handle.h"
+#include "../common/position_2d.h"
+#include "../common/rectangle_2d.h"
+#include "tile_storage.h"
+
+// Read-only handle to one tile of a WorldTileStorage. Two words, so pass it by value;
+// it stays valid as long as the storage does.
+class WorldTileView {
+public:
+  WorldTileView(const WorldTileStorage&, int index);
+
+  int Index() const;
+  int X() const;
+  int Y() const;
+  // Tile center in grid coordinates
+  Position2D Pos() const;
+  const WorldTileTerrainType& TerrainType() const;
+  ImageHandle Sprite(TileFrameStyle style) const;
+  Rectangle2D AtlasRect() const;
+  Color2D MinimapColor() const;
+  bool HasDecoration() const;
+  WorldDecorationType Decoration() const;
+  uint32_t DecorationState() const;
+  bool HasResource() const;
+  ResourceType Resource() const;
+  uint32_t ResourceVolume() const;
+  uint32_t ResourceInitialVolume() const;
+
+private:
+  const WorldTileStorage* storage;
+  int index;
+};
@@ -0,0 +1,97 @@
+#include <cstdlib>
+#include <iostream>
+#include <set>
+#include <vector>
+
+#include "common/tile_dirty_set.h"
+
+namespace {
+
+int failures = 0;
+
+void check(bool condition, const char* what) {
+  if (!condition) {
+    std::cerr << "FAILED: " << what << std::endl;
+    ++failures;
+  }
+}
+
+// Marking and draining one tile over and over must not grow the change list
+void testRepeatedMarkAndDrainStaysBounded() {
+  TileDirtySet dirty(64, 64, 16);
+  int chunk = dirty.ChunkIndex(5, 5);
+  for (int i = 0; i < 200000; ++i) {
+    dirty.Mark(5, 5);
+    dirty.DrainChunk(chunk, [](int, int) {});
+  }
+  check(dirty.IsEmpty(), "set is empty after the last drain");
+  check(dirty.ChangeListSize() <= 1, "change list holds at most one entry for one tile");
+
+  int visited = 0;
+  dirty.Mark(5, 5);
+  dirty.DrainAll([&](int x, int y) { visited += (x == 5 && y == 5) ? 1 : 100; });
+  check(visited == 1, "tile is visited once after re-marking");
+  check(dirty.ChangeListSize() == 0, "drain all empties the change list");
+}
+
+// Re-marking a whole drained map keeps at most one entry per tile
+void testStaleEntriesAreCompacted() {
+  TileDirtySet dirty(256, 256, 32);
+  for (int round = 0; round < 20; ++round) {
+    for (int y = 0; y < 256; ++y) {
+      for (int x = 0; x < 256; ++x) dirty.Mark(x, y);
+    }
+    for (int chunk : std::vector<int>(dirty.DirtyChunks())) {
+      dirty.DrainChunk(chunk, [](int, int) {});
+    }
+  }
+  check(dirty.ChangeListSize() <= 256 * 256, "change list never exceeds one entry per tile");
+}
+
+void testMarkAllDrainsEveryTileOnce() {
+  TileDirtySet dirty(100, 70, 12);
+  dirty.Mark(3, 4);
+  dirty.MarkAll();
+  check(dirty.Count() == 100 * 70, "mark all counts every tile");
+
+  std::set<int> seen;
+  bool inside = true;
+  dirty.DrainAll([&](int x, int y) {
+    inside = inside && x < 100 && y < 70;
+    seen.insert(y * 100 + x);
+  });
+  check(inside, "drained tiles lie inside the map");
+  check(seen.size() == 100 * 70, "every tile drained once");
+  check(dirty.IsEmpty() && dirty.DirtyChunks().empty(), "set is empty after drain all");
+}
+
+void testDrainChunksClearsWholeChunks() {
+  TileDirtySet dirty(100, 70, 32);
+  dirty.MarkAll();
+  dirty.Mark(1, 1);
+  int chunks = 0;
+  dirty.DrainChunks([&](int) { ++chunks; });
+  check(chunks == 4 * 3, "every chunk visited once");
+  check(dirty.IsEmpty() && dirty.DirtyChunks().empty(), "set is empty after draining chunks");
+
+  dirty.Mark(40, 40);
+  chunks = 0;
+  dirty.DrainChunks([&](int chunk) { chunks += chunk == dirty.ChunkIndex(40, 40) ? 1 : 100; });
+  check(chunks == 1, "only the changed chunk is visited");
+  check(dirty.ChangeListSize() == 0, "draining chunks empties the change list");
+}
+
+}
+
+int main() {
+  testRepeatedMarkAndDrainStaysBounded();
+  testStaleEntriesAreCompacted();
+  testMarkAllDrainsEveryTileOnce();
+  testDrainChunksClearsWholeChunks();
+  if (failures) {
+    std::cerr << failures << " check(s) failed" << std::endl;
+    return EXIT_FAILURE;
+  }
+  std::cout << "tile_dirty_set_test passed" << std::endl;
+  return EXIT_SUCCESS;
+}